@@ -0,0 +1,765 @@
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "ge.h"
+#include "msl.h"
+#include "log.h"
+#include "console_socket.h"
+#include "deck.h"
+#include "output.h"
+#include "snapshot.h"
+#include "mem.h"
+#include "insn.h"
+#include "profile.h"
+
+#define MAX_LINE 1024
+#define MAX_NAME 64
+
+enum job_status {
+    JOB_PENDING,
+    JOB_HALTED,   ///< The machine halted (ALTO set)
+    JOB_BUDGET,   ///< The cycle budget run out
+    JOB_ERROR,    ///< The emulator returned an error
+    JOB_IO_ERROR, ///< The job files could not be read
+};
+
+static const char *job_status_name(enum job_status s)
+{
+    switch (s) {
+        case JOB_PENDING:  return "pending";
+        case JOB_HALTED:   return "halted";
+        case JOB_BUDGET:   return "budget";
+        case JOB_ERROR:    return "error";
+        case JOB_IO_ERROR: return "io-error";
+    }
+
+    return "";
+}
+
+/**
+ * A job of the manifest
+ *
+ * One line of the manifest, i.e. a name followed by `key=value` fields:
+ *
+ *     # name   fields...
+ *     loader   deck=loader.bin cycles=100000
+ *     hlt      program=hlt.bin switches=SITE,INAR am=0x00ff
+ *     print    deck=print.bin st3=printer:print.txt
+ *     watched  deck=loader.bin console=/tmp/watched.console
+ *
+ * A job can start from a snapshot saved by a previous run instead of
+ * clearing and starting the machine, e.g. to skip the initial load.
+ */
+struct job {
+    char name[MAX_NAME];
+    char program[PATH_MAX]; ///< Image copied at the start of memory, MEM_SIZE at most
+    char deck[PATH_MAX];    ///< Card deck (see deck.h), loaded with the LOAD button
+    uint8_t load_2;         ///< Load the deck from LOAD 2 instead of LOAD 1
+    char st3[PATH_MAX];     ///< Output unit on ST3, `kind:path` (see output.h)
+    char st4[PATH_MAX];     ///< Output unit on ST4
+    char console[PATH_MAX]; ///< Socket to serve the consoles on (see console_socket.h)
+    char snapshot[PATH_MAX]; ///< Snapshot to resume from
+    char save[PATH_MAX];    ///< Where to save the snapshot at the end
+    struct ge_console_switches switches;
+    uint8_t has_switches;   ///< The switches are set, and override the snapshot ones
+    uint64_t budget;        ///< Maximum number of cycles to run
+
+    /* results */
+    enum job_status status;
+    uint64_t cycles;
+    uint32_t mem_hash;
+    uint8_t  rSO;
+    uint16_t rPO;
+    uint8_t  ffFA;
+    uint8_t  ffFI;
+    uint16_t rV1, rV2, rV3, rV4;
+    uint16_t rL1, rL3;
+    uint8_t  rL2;
+};
+
+/**
+ * Worker of the thread pool
+ *
+ * Each worker has its own deque of job indexes: it takes jobs from the
+ * bottom of its own deque, and when it is empty, it steals from the
+ * top of the deques of the other workers.
+ */
+struct worker {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    int *jobs;
+    int top;
+    int bottom;
+
+    int id;
+    struct pool *pool;
+
+    struct ge_profile *profile; ///< Counters of the jobs run by the worker
+};
+
+struct pool {
+    struct job *jobs;
+    struct worker *workers;
+    int nworkers;
+
+    ge_log_type log_types;
+    const char *dump_dir;
+    const char *listing_dir; ///< Profile the instructions, write the listings here
+    uint8_t insn;   ///< Run whole instructions when possible, see insn.h
+    const char *profile_path; ///< Profile the jobs, write the report here
+};
+
+static uint8_t *read_file(const char *path, size_t *size)
+{
+    uint8_t *data = NULL;
+    size_t used = 0, allocated = 0, r;
+    FILE *f = fopen(path, "rb");
+
+    if (f == NULL)
+        return NULL;
+
+    do {
+        if (used == allocated) {
+            uint8_t *p;
+            allocated = allocated ? allocated * 2 : 0x1000;
+            p = realloc(data, allocated);
+            if (p == NULL) {
+                free(data);
+                fclose(f);
+                return NULL;
+            }
+            data = p;
+        }
+
+        r = fread(data + used, 1, allocated - used, f);
+        used += r;
+    } while (r > 0);
+
+    if (ferror(f)) {
+        free(data);
+        data = NULL;
+    }
+
+    fclose(f);
+    *size = used;
+    return data;
+}
+
+static uint32_t mem_hash(struct ge *ge)
+{
+    /* FNV-1a */
+    uint32_t h = 0x811c9dc5;
+    const uint8_t *page;
+    int i, j;
+
+    for (i = 0; i < MEM_PAGES; i++) {
+        page = ge_mem_page_data(ge, i);
+
+        for (j = 0; j < MEM_PAGE_SIZE; j++) {
+            h ^= page[j];
+            h *= 0x01000193;
+        }
+    }
+
+    return h;
+}
+
+static void dump_memory(struct pool *pool, struct job *job, struct ge *ge)
+{
+    char path[PATH_MAX];
+    FILE *f;
+    int i;
+
+    snprintf(path, sizeof(path), "%s/%s.mem", pool->dump_dir, job->name);
+
+    f = fopen(path, "wb");
+    if (f == NULL) {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return;
+    }
+
+    for (i = 0; i < MEM_PAGES; i++)
+        fwrite(ge_mem_page_data(ge, i), 1, MEM_PAGE_SIZE, f);
+    fclose(f);
+}
+
+static void write_listing(struct pool *pool, struct job *job, struct ge *ge)
+{
+    char path[PATH_MAX];
+    FILE *f;
+
+    snprintf(path, sizeof(path), "%s/%s.lst", pool->listing_dir, job->name);
+
+    f = fopen(path, "w");
+    if (f == NULL) {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return;
+    }
+
+    ge_guest_profile_print(ge->guest_profile, ge, f);
+    fclose(f);
+}
+
+static void save_snapshot(struct job *job, struct ge *ge)
+{
+    FILE *f = fopen(job->save, "wb");
+
+    if (f == NULL) {
+        fprintf(stderr, "%s: %s\n", job->save, strerror(errno));
+        return;
+    }
+
+    if (ge_snapshot_save(ge, f) != 0)
+        fprintf(stderr, "%s: cannot save snapshot\n", job->save);
+
+    fclose(f);
+}
+
+static int open_output(struct ge *ge, struct ge_output *out, const char *spec,
+                       struct ge_connector *connector)
+{
+    enum ge_output_kind kind;
+    const char *path;
+
+    if (ge_output_parse(spec, &kind, &path) != 0 ||
+        ge_output_open(out, kind, path) != 0)
+        return -1;
+
+    return ge_output_register(ge, out, connector);
+}
+
+static void run_job(struct pool *pool, struct job *job, struct ge_profile *profile)
+{
+    struct ge_guest_profile *guest_profile = NULL;
+    struct ge_deck deck = { 0 };
+    struct ge_output st3 = { 0 }, st4 = { 0 };
+    uint8_t *program = NULL;
+    size_t size = 0;
+    struct ge *ge;
+    int r = 0;
+
+    /* too big for the worker stack */
+    ge = malloc(sizeof(*ge));
+    if (ge == NULL) {
+        job->status = JOB_ERROR;
+        return;
+    }
+
+    ge_init(ge);
+
+    if (profile)
+        ge_set_profile(ge, profile);
+
+    if (pool->listing_dir) {
+        guest_profile = malloc(sizeof(*guest_profile));
+        if (guest_profile == NULL) {
+            job->status = JOB_ERROR;
+            goto out;
+        }
+
+        ge_guest_profile_init(guest_profile);
+        ge_set_guest_profile(ge, guest_profile);
+    }
+
+    if (job->deck[0]) {
+        if (ge_deck_open(&deck, job->deck) != 0) {
+            job->status = JOB_IO_ERROR;
+            goto out;
+        }
+
+        if (ge_deck_register(ge, &deck) != 0) {
+            job->status = JOB_ERROR;
+            goto out;
+        }
+    }
+
+    if ((job->st3[0] && open_output(ge, &st3, job->st3, &ge->ST3) != 0) ||
+        (job->st4[0] && open_output(ge, &st4, job->st4, &ge->ST4) != 0)) {
+        job->status = JOB_IO_ERROR;
+        goto out;
+    }
+
+    if (job->console[0] && console_socket_register(ge, job->console) != 0) {
+        job->status = JOB_IO_ERROR;
+        goto out;
+    }
+
+    if (job->snapshot[0]) {
+        FILE *f = fopen(job->snapshot, "rb");
+
+        if (f == NULL) {
+            job->status = JOB_IO_ERROR;
+            goto out;
+        }
+
+        r = ge_snapshot_load(ge, f);
+        fclose(f);
+
+        if (r != 0) {
+            job->status = JOB_IO_ERROR;
+            goto out;
+        }
+    }
+
+    if (job->program[0]) {
+        program = read_file(job->program, &size);
+        if (program == NULL) {
+            job->status = JOB_IO_ERROR;
+            goto out;
+        }
+
+        /* the whole image, not more than the memory */
+        if (ge_mem_load(ge, 0, program, size) != 0) {
+            job->status = JOB_IO_ERROR;
+            goto out;
+        }
+    }
+
+    if (!job->snapshot[0] || job->has_switches)
+        ge_set_console_switches(ge, &job->switches);
+
+    if (!job->snapshot[0]) {
+        ge_clear(ge);
+
+        if (job->deck[0]) {
+            if (job->load_2)
+                ge_load_2(ge);
+            else
+                ge_load_1(ge);
+
+            ge_load(ge);
+        }
+
+        ge_start(ge);
+    }
+
+    job->status = JOB_BUDGET;
+
+    while (job->cycles < job->budget) {
+        if (pool->insn) {
+            r = ge_run_step(ge, &job->cycles);
+        } else {
+            r = ge_run_cycle(ge);
+            job->cycles++;
+        }
+
+        if (r != 0) {
+            job->status = JOB_ERROR;
+            break;
+        }
+
+        if (ge->ALTO) {
+            job->status = JOB_HALTED;
+            break;
+        }
+    }
+
+    job->mem_hash = mem_hash(ge);
+    job->rSO  = ge->rSO;
+    job->rPO  = ge->rPO;
+    job->ffFA = ge->ffFA;
+    job->ffFI = ge->ffFI;
+    job->rV1  = ge->rV1;
+    job->rV2  = ge->rV2;
+    job->rV3  = ge->rV3;
+    job->rV4  = ge->rV4;
+    job->rL1  = ge->rL1;
+    job->rL2  = ge->rL2;
+    job->rL3  = ge->rL3;
+
+    if (pool->dump_dir)
+        dump_memory(pool, job, ge);
+
+    if (pool->listing_dir)
+        write_listing(pool, job, ge);
+
+    if (job->save[0])
+        save_snapshot(job, ge);
+
+out:
+    ge_deinit(ge);
+    free(guest_profile);
+    ge_deck_close(&deck);
+
+    /* waits for the output units to write their records */
+    if (ge_output_close(&st3) != 0)
+        job->status = JOB_IO_ERROR;
+    if (ge_output_close(&st4) != 0)
+        job->status = JOB_IO_ERROR;
+
+    free(program);
+    free(ge);
+}
+
+static int worker_pop(struct worker *w)
+{
+    int j = -1;
+
+    pthread_mutex_lock(&w->lock);
+    if (w->bottom > w->top)
+        j = w->jobs[--w->bottom];
+    pthread_mutex_unlock(&w->lock);
+
+    return j;
+}
+
+static int worker_steal(struct worker *w)
+{
+    int j = -1;
+
+    pthread_mutex_lock(&w->lock);
+    if (w->bottom > w->top)
+        j = w->jobs[w->top++];
+    pthread_mutex_unlock(&w->lock);
+
+    return j;
+}
+
+static void *worker_run(void *arg)
+{
+    struct worker *w = arg;
+    struct pool *pool = w->pool;
+    int i, j;
+
+    ge_log_set_active_types(pool->log_types);
+
+    for (;;) {
+        j = worker_pop(w);
+
+        /* jobs are never added once started, so if all the deques
+         * are empty, there is nothing left to do */
+        for (i = 1; j < 0 && i < pool->nworkers; i++)
+            j = worker_steal(&pool->workers[(w->id + i) % pool->nworkers]);
+
+        if (j < 0)
+            break;
+
+        run_job(pool, &pool->jobs[j], w->profile);
+    }
+
+    return NULL;
+}
+
+static int parse_switches(struct ge_console_switches *s, char *list)
+{
+    char *name;
+
+    for (name = strtok(list, ","); name; name = strtok(NULL, ",")) {
+        if      (strcmp(name, "PAPA") == 0) s->PAPA = 1;
+        else if (strcmp(name, "PATE") == 0) s->PATE = 1;
+        else if (strcmp(name, "RICI") == 0) s->RICI = 1;
+        else if (strcmp(name, "ACOV") == 0) s->ACOV = 1;
+        else if (strcmp(name, "ACON") == 0) s->ACON = 1;
+        else if (strcmp(name, "INAR") == 0) s->INAR = 1;
+        else if (strcmp(name, "STOC") == 0) s->STOC = 1;
+        else if (strcmp(name, "INCE") == 0) s->INCE = 1;
+        else if (strcmp(name, "SITE") == 0) s->SITE = 1;
+        else return -1;
+    }
+
+    return 0;
+}
+
+static int parse_job(struct job *job, char *line, uint64_t default_budget)
+{
+    char *save, *field, *value;
+
+    memset(job, 0, sizeof(*job));
+    job->budget = default_budget;
+
+    field = strtok_r(line, " \t\n", &save);
+    snprintf(job->name, sizeof(job->name), "%s", field);
+
+    while ((field = strtok_r(NULL, " \t\n", &save)) != NULL) {
+        value = strchr(field, '=');
+        if (value == NULL)
+            return -1;
+        *value++ = 0;
+
+        if (strcmp(field, "program") == 0)
+            snprintf(job->program, sizeof(job->program), "%s", value);
+        else if (strcmp(field, "deck") == 0)
+            snprintf(job->deck, sizeof(job->deck), "%s", value);
+        else if (strcmp(field, "snapshot") == 0)
+            snprintf(job->snapshot, sizeof(job->snapshot), "%s", value);
+        else if (strcmp(field, "save") == 0)
+            snprintf(job->save, sizeof(job->save), "%s", value);
+        else if (strcmp(field, "st3") == 0 || strcmp(field, "st4") == 0) {
+            enum ge_output_kind kind;
+            const char *path;
+
+            if (ge_output_parse(value, &kind, &path) != 0)
+                return -1;
+
+            if (field[2] == '3')
+                snprintf(job->st3, sizeof(job->st3), "%s", value);
+            else
+                snprintf(job->st4, sizeof(job->st4), "%s", value);
+        }
+        else if (strcmp(field, "console") == 0)
+            snprintf(job->console, sizeof(job->console), "%s", value);
+        else if (strcmp(field, "load") == 0)
+            job->load_2 = strcmp(value, "2") == 0;
+        else if (strcmp(field, "switches") == 0) {
+            if (parse_switches(&job->switches, value) != 0)
+                return -1;
+            job->has_switches = 1;
+        }
+        else if (strcmp(field, "am") == 0) {
+            job->switches.AM = strtoul(value, NULL, 0);
+            job->has_switches = 1;
+        }
+        else if (strcmp(field, "cycles") == 0)
+            job->budget = strtoull(value, NULL, 0);
+        else
+            return -1;
+    }
+
+    return 0;
+}
+
+static struct job *read_manifest(const char *path, int *njobs, uint64_t default_budget)
+{
+    struct job *jobs = NULL, *p;
+    char line[MAX_LINE];
+    int n = 0, lineno = 0;
+    char *s;
+    FILE *f;
+
+    f = fopen(path, "r");
+    if (f == NULL) {
+        perror(path);
+        return NULL;
+    }
+
+    while (fgets(line, sizeof(line), f)) {
+        lineno++;
+
+        for (s = line; *s == ' ' || *s == '\t'; s++)
+            ;
+
+        if (*s == '#' || *s == '\n' || *s == 0)
+            continue;
+
+        p = realloc(jobs, (n + 1) * sizeof(*jobs));
+        if (p == NULL) {
+            perror("realloc");
+            goto error;
+        }
+        jobs = p;
+
+        if (parse_job(&jobs[n], s, default_budget) != 0) {
+            fprintf(stderr, "%s:%d: invalid job\n", path, lineno);
+            goto error;
+        }
+
+        n++;
+    }
+
+    fclose(f);
+    *njobs = n;
+    return jobs;
+
+error:
+    fclose(f);
+    free(jobs);
+    return NULL;
+}
+
+static void write_results(FILE *out, struct job *jobs, int njobs)
+{
+    int i;
+
+    fprintf(out, "# name\tstatus\tcycles\tSO\tPO\tFA\tFI\tV1\tV2\tV3\tV4\tL1\tL2\tL3\tmem\n");
+
+    for (i = 0; i < njobs; i++) {
+        struct job *j = &jobs[i];
+
+        fprintf(out,
+                "%s\t%s\t%llu\t"
+                "%02x\t%04x\t%02x\t%02x\t"
+                "%04x\t%04x\t%04x\t%04x\t"
+                "%04x\t%02x\t%04x\t%08x\n",
+                j->name, job_status_name(j->status), (unsigned long long)j->cycles,
+                j->rSO, j->rPO, j->ffFA, j->ffFI,
+                j->rV1, j->rV2, j->rV3, j->rV4,
+                j->rL1, j->rL2, j->rL3, j->mem_hash);
+    }
+}
+
+/* Merge the profiles of the workers, print the report and write it */
+static int write_profile(struct pool *pool)
+{
+    struct ge_profile *profile = pool->workers[0].profile;
+    FILE *f;
+    int i, r;
+
+    for (i = 1; i < pool->nworkers; i++)
+        ge_profile_merge(profile, pool->workers[i].profile);
+
+    ge_profile_print(profile, stderr);
+
+    f = fopen(pool->profile_path, "w");
+    if (f == NULL) {
+        perror(pool->profile_path);
+        return -1;
+    }
+
+    r = ge_profile_write_json(profile, f);
+    fclose(f);
+    return r;
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+            "usage: %s [-j threads] [-c cycles] [-o results] [-d dump-dir] [-l log-types] [-i]\n"
+            "          [-P profile.json] [-L listing-dir] manifest\n"
+            "\n"
+            "  -j threads    number of worker threads (default: number of cpus)\n"
+            "  -c cycles     default cycle budget of the jobs (default 1000000)\n"
+            "  -o results    write the results here instead of stdout\n"
+            "  -d dump-dir   dump the memory of every job in dump-dir/name.mem\n"
+            "  -l log-types  log types enabled in the workers (default 0)\n"
+            "  -i            run whole instructions when possible, instead of\n"
+            "                every single cycle\n"
+            "  -P file       profile the states and the timing charts of all the\n"
+            "                jobs, print the report and write it as JSON in file\n"
+            "  -L dir        profile the instructions of every job, write their\n"
+            "                annotated listing in dir/name.lst\n"
+            "\n"
+            "Every line of the manifest is a job: a name followed by the fields\n"
+            "  program=path    image copied at the start of memory, io-error if\n"
+            "                  larger than the memory\n"
+            "  deck=path       card deck, loaded with the LOAD button\n"
+            "  load=1|2        LOAD 1 or LOAD 2 (default 1)\n"
+            "  st3=kind:path   printer or punch on ST3, writing to path\n"
+            "  st4=kind:path   printer or punch on ST4\n"
+            "  console=path    serve the consoles on the socket at path\n"
+            "  switches=A,B    console switches, e.g. SITE,INAR\n"
+            "  am=value        console AM switches\n"
+            "  cycles=n        cycle budget\n"
+            "  snapshot=path   resume from a snapshot instead of clearing the machine\n"
+            "  save=path       save a snapshot when the job ends\n"
+            "\n"
+            "Jobs run concurrently, so a snapshot saved by a job should be used\n"
+            "by the jobs of a later run.\n",
+            name);
+}
+
+int main(int argc, char *argv[])
+{
+    struct pool pool = { 0 };
+    uint64_t budget = 1000000;
+    const char *results = NULL;
+    FILE *out = stdout;
+    int nworkers = sysconf(_SC_NPROCESSORS_ONLN);
+    int njobs = 0;
+    int i, opt;
+
+    while ((opt = getopt(argc, argv, "j:c:o:d:l:iP:L:h")) != -1) {
+        switch (opt) {
+            case 'j': nworkers = atoi(optarg);                    break;
+            case 'c': budget = strtoull(optarg, NULL, 0);         break;
+            case 'o': results = optarg;                           break;
+            case 'd': pool.dump_dir = optarg;                     break;
+            case 'l': pool.log_types = strtol(optarg, NULL, 0);   break;
+            case 'i': pool.insn = 1;                              break;
+            case 'P': pool.profile_path = optarg;                 break;
+            case 'L': pool.listing_dir = optarg;                  break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (optind != argc - 1 || nworkers <= 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    pool.jobs = read_manifest(argv[optind], &njobs, budget);
+    if (pool.jobs == NULL)
+        return 1;
+
+    if (nworkers > njobs)
+        nworkers = njobs ? njobs : 1;
+
+    pool.nworkers = nworkers;
+    pool.workers = calloc(nworkers, sizeof(struct worker));
+    if (pool.workers == NULL) {
+        perror("calloc");
+        return 1;
+    }
+
+    /* not thread safe, must be done before starting the workers */
+    msl_init();
+
+    for (i = 0; i < nworkers; i++) {
+        struct worker *w = &pool.workers[i];
+
+        w->id = i;
+        w->pool = &pool;
+        w->jobs = calloc(njobs ? njobs : 1, sizeof(int));
+        if (w->jobs == NULL) {
+            perror("calloc");
+            return 1;
+        }
+        pthread_mutex_init(&w->lock, NULL);
+
+        if (pool.profile_path) {
+            w->profile = malloc(sizeof(*w->profile));
+            if (w->profile == NULL) {
+                perror("malloc");
+                return 1;
+            }
+            ge_profile_init(w->profile);
+        }
+    }
+
+    /* deal the jobs round robin, stealing will balance the rest */
+    for (i = 0; i < njobs; i++) {
+        struct worker *w = &pool.workers[i % nworkers];
+        w->jobs[w->bottom++] = i;
+    }
+
+    for (i = 0; i < nworkers; i++) {
+        if (pthread_create(&pool.workers[i].thread, NULL, worker_run, &pool.workers[i]) != 0) {
+            perror("pthread_create");
+            return 1;
+        }
+    }
+
+    for (i = 0; i < nworkers; i++)
+        pthread_join(pool.workers[i].thread, NULL);
+
+    if (results) {
+        out = fopen(results, "w");
+        if (out == NULL) {
+            perror(results);
+            return 1;
+        }
+    }
+
+    write_results(out, pool.jobs, njobs);
+
+    if (out != stdout)
+        fclose(out);
+
+    if (pool.profile_path && write_profile(&pool) != 0)
+        return 1;
+
+    for (i = 0; i < nworkers; i++) {
+        pthread_mutex_destroy(&pool.workers[i].lock);
+        free(pool.workers[i].jobs);
+        free(pool.workers[i].profile);
+    }
+
+    free(pool.workers);
+    free(pool.jobs);
+    return 0;
+}
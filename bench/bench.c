@@ -0,0 +1,861 @@
+/**
+ * @file  bench.c
+ * @brief Benchmarks of the core engine
+ *
+ * Every benchmark runs its body for a number of iterations, doubled
+ * until a run takes at least the minimum time, then repeats the run and
+ * reports the median. The results are printed as a table, and can be
+ * written as JSON to track them over time.
+ *
+ * The whole program benchmarks assemble the listings of software/ (see
+ * load_listing()), and run them from the first instruction over and
+ * over: they start again when the program halts or stops on an error,
+ * and the time taken to restart is not counted. The integrated reader
+ * is fed with cards of NOP2, for the programs reading cards.
+ *
+ * With -b, the results are kept in a file, keyed by the git revision
+ * they were taken at, and compared with the ones of the last other
+ * revision in the file (or the one given with -B): a benchmark has
+ * regressed when its median got slower by more than the threshold, and
+ * its confidence interval does not overlap the one of the baseline.
+ * The exit status is then 2.
+ *
+ * Usage: bench [-f filter] [-t min-seconds] [-r repetitions]
+ *              [-s software-dir] [-j results.json]
+ *              [-b baseline-file] [-R revision] [-B baseline-revision]
+ *              [-T threshold-percent]
+ */
+
+#include <ctype.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../deck.h"
+#include "../ge.h"
+#include "../insn.h"
+#include "../log.h"
+#include "../mem.h"
+#include "../msl.h"
+#include "../msl-timings.h"
+#include "../opcodes.h"
+#include "../peripherical.h"
+#include "../signals.h"
+
+#define NSEC_PER_SEC 1000000000LL
+
+#define MAX_ITERATIONS (1ULL << 40)
+#define MAX_REPETITIONS 32
+#define MAX_LINE 256
+#define MAX_REVISION 64
+#define DECK_CARDS 1024
+
+/* Exit status when a benchmark regressed */
+#define EXIT_REGRESSION 2
+
+struct bench;
+
+/**
+ * Body of a benchmark
+ *
+ * Runs `iterations` iterations, returns the number of items processed
+ * (e.g. pulses or cycles), or 0 on errors.
+ */
+typedef uint64_t (*bench_cb)(struct bench *b, uint64_t iterations);
+
+struct bench {
+    const char *name;
+    const char *unit;   ///< What the items are, e.g. "pulses"
+    bench_cb run;
+    const char *arg;    ///< Listing for the whole program benchmarks
+    uint8_t state;      ///< State for msl_run_state
+
+    /* results */
+    uint64_t iterations;
+    double ns_per_item;      ///< Median of the repetitions
+    double ci_low;           ///< Confidence interval of the median, see median_ci()
+    double ci_high;
+    double items_per_second;
+    double insns_per_second; ///< Instructions fetched, for the programs
+
+    /* baseline, see read_baseline() */
+    uint8_t has_baseline;
+    double base_ns_per_item;
+    double base_ci_low;
+    double base_ci_high;
+};
+
+static const char *software_dir = "software";
+
+/* The machine of the benchmarks, and its state at the beginning */
+static struct ge machine, initial;
+
+/* Instructions fetched by the last run, see count_fetch() */
+static uint64_t fetches;
+
+/* Time spent by the last run restarting the programs, see restart() */
+static int64_t restart_ns;
+
+/* Cards of NOP2 for the integrated reader, long enough for binary cards */
+static uint8_t nop2_cards[DECK_CARDS * 2 * GE_DECK_COLUMNS];
+static struct ge_deck deck;
+
+static volatile uint16_t sink;
+
+static int64_t monotonic_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+/* Only the digits, the listings often have O for 0 */
+static int parse_hex(const char *s, int digits, uint16_t *value)
+{
+    int i, c;
+
+    *value = 0;
+
+    for (i = 0; i < digits; i++) {
+        c = toupper((unsigned char)s[i]);
+        if (c == 'O')
+            c = '0';
+        if (!isxdigit(c))
+            return -1;
+
+        *value = *value << 4 | (isdigit(c) ? c - '0' : c - 'A' + 10);
+    }
+
+    return isspace((unsigned char)s[digits]) || s[digits] == 0 ? 0 : -1;
+}
+
+/**
+ * Assemble a listing of software/
+ *
+ * Every line is an address, a mnemonic and the characters of the
+ * instruction, as many as given by its format (see state E0), followed
+ * by a comment. The lines that do not parse are skipped.
+ *
+ * @return the lowest address, or -1 if nothing could be loaded
+ */
+static int load_listing(struct ge *ge, const char *name)
+{
+    char path[MAX_LINE], line[MAX_LINE];
+    char *s, *save;
+    uint16_t addr, c;
+    int start = -1, len, i;
+    uint8_t chars[6];
+    FILE *f;
+
+    snprintf(path, sizeof(path), "%s/%s", software_dir, name);
+
+    f = fopen(path, "r");
+    if (f == NULL) {
+        perror(path);
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), f)) {
+        s = strtok_r(line, " \t\n", &save);
+        if (s == NULL || strlen(s) != 4 || parse_hex(s, 4, &addr) != 0)
+            continue;
+
+        /* the mnemonic */
+        if (strtok_r(NULL, " \t\n", &save) == NULL)
+            continue;
+
+        s = strtok_r(NULL, " \t\n", &save);
+        if (s == NULL || parse_hex(s, 2, &c) != 0)
+            continue;
+
+        chars[0] = c;
+        len = 2 + 2 * BIT(chars[0], 6) + 2 * BIT(chars[0], 7);
+
+        s = strtok_r(NULL, " \t\n", &save);
+        if (s == NULL || parse_hex(s, 2, &c) != 0)
+            continue;
+        chars[1] = c;
+
+        for (i = 2; i < len; i += 2) {
+            s = strtok_r(NULL, " \t\n", &save);
+            if (s == NULL || parse_hex(s, 4, &c) != 0)
+                break;
+
+            chars[i] = c >> 8;
+            chars[i + 1] = c & 0xff;
+        }
+
+        if (i < len)
+            continue;
+
+        ge_mem_load(ge, addr, chars, len);
+
+        if (start < 0 || addr < start)
+            start = addr;
+    }
+
+    fclose(f);
+    return start;
+}
+
+/* Back to the first card, with the machine back to `initial` */
+static void rewind_deck(void)
+{
+    deck.pos = 0;
+    deck.card_end = 0;
+    deck.cards = 0;
+}
+
+/* A machine fetching the instruction at `start` */
+static int setup_program(const char *listing)
+{
+    static uint8_t nops[MEM_SIZE];
+    int start = 0, i;
+
+    ge_init(&machine);
+    ge_clear(&machine);
+
+    if (listing) {
+        start = load_listing(&machine, listing);
+        if (start < 0)
+            return -1;
+
+        memset(nop2_cards, NOP2_OPCODE, sizeof(nop2_cards));
+        ge_deck_init(&deck, nop2_cards, sizeof(nop2_cards));
+        if (ge_deck_register(&machine, &deck) != 0)
+            return -1;
+    } else {
+        /* NOP2 all over the memory */
+        for (i = 0; i < MEM_SIZE; i += 2) {
+            nops[i] = NOP2_OPCODE;
+            nops[i + 1] = 0x00;
+        }
+        ge_mem_load(&machine, 0, nops, MEM_SIZE);
+    }
+
+    ge_start(&machine);
+
+    /* display and initialitiation */
+    ge_run_cycle(&machine);
+    ge_run_cycle(&machine);
+
+    machine.rPO = start;
+    knots_changed(&machine);
+    initial = machine;
+    return 0;
+}
+
+static void count_fetch(struct ge *ge)
+{
+    if (ge->rSA == 0xe2 || ge->rSA == 0xe3)
+        fetches++;
+}
+
+/* Start again when the program halts or stops on an error */
+static void restart(struct ge *ge, int r)
+{
+    int64_t start;
+
+    if (r == 0 && !ge->ALTO)
+        return;
+
+    start = monotonic_ns();
+    *ge = initial;
+    rewind_deck();
+    restart_ns += monotonic_ns() - start;
+}
+
+static uint64_t bench_pulse(struct bench *b, uint64_t iterations)
+{
+    uint64_t i;
+    int r;
+
+    for (i = 0; i < iterations; i++) {
+        r = ge_run_pulse(&machine);
+        restart(&machine, r);
+    }
+
+    return iterations;
+}
+
+static uint64_t bench_cycle(struct bench *b, uint64_t iterations)
+{
+    uint64_t i;
+    int r;
+
+    for (i = 0; i < iterations; i++) {
+        r = ge_run_cycle(&machine);
+        count_fetch(&machine);
+        restart(&machine, r);
+    }
+
+    return iterations;
+}
+
+static uint64_t bench_step(struct bench *b, uint64_t iterations)
+{
+    uint64_t cycles = 0, insns;
+    int r;
+
+    while (cycles < iterations) {
+        insns = cycles;
+        r = ge_run_step(&machine, &cycles);
+
+        /* a whole instruction, or a single cycle */
+        if (cycles - insns > 1)
+            fetches++;
+        else
+            count_fetch(&machine);
+
+        restart(&machine, r);
+    }
+
+    return cycles;
+}
+
+/* A whole cycle of a state, running every clock */
+static uint64_t bench_state(struct bench *b, uint64_t iterations)
+{
+    struct msl_timing_state *state = msl_get_state(b->state);
+    uint64_t i;
+    int c;
+
+    for (i = 0; i < iterations; i++) {
+        machine.rSA = b->state;
+
+        for (c = 0; c < END_OF_STATUS; c++) {
+            machine.current_clock = c;
+            msl_run_state(&machine, state);
+        }
+    }
+
+    machine.current_clock = TO00;
+    return iterations;
+}
+
+static uint64_t bench_no_knot(struct bench *b, uint64_t iterations)
+{
+    uint64_t i;
+
+    for (i = 0; i < iterations; i++) {
+        knots_changed(&machine);
+        machine.kNO.cmd = i & 7;
+        sink = NO_knot(&machine);
+    }
+
+    return iterations;
+}
+
+static uint64_t bench_ni_knot(struct bench *b, uint64_t iterations)
+{
+    uint64_t i;
+
+    for (i = 0; i < iterations; i++) {
+        knots_changed(&machine);
+        machine.rBO = i;
+        sink = NI_knot(&machine);
+    }
+
+    return iterations;
+}
+
+static uint64_t bench_knots_cached(struct bench *b, uint64_t iterations)
+{
+    uint64_t i;
+
+    for (i = 0; i < iterations; i++)
+        sink = NO_knot(&machine) ^ NI_knot(&machine);
+
+    return iterations;
+}
+
+static uint64_t bench_na_knot(struct bench *b, uint64_t iterations)
+{
+    uint64_t i;
+
+    for (i = 0; i < iterations; i++) {
+        machine.rSO = i;
+        sink = NA_knot(&machine);
+    }
+
+    return iterations;
+}
+
+static uint64_t bench_log_disabled(struct bench *b, uint64_t iterations)
+{
+    uint64_t i;
+
+    ge_log_set_active_types(0);
+
+    for (i = 0; i < iterations; i++)
+        ge_log(LOG_CMDS, "    %s %llu\n", b->name, (unsigned long long)i);
+
+    return iterations;
+}
+
+static struct bench benches[] = {
+    { "ge_run_pulse/nop2",          "pulses",  bench_pulse },
+    { "ge_run_cycle/nop2",          "cycles",  bench_cycle },
+    { "ge_run_step/nop2",           "cycles",  bench_step },
+    { "msl_run_state/00",           "states",  bench_state, NULL, 0x00 },
+    { "msl_run_state/80",           "states",  bench_state, NULL, 0x80 },
+    { "msl_run_state/e2",           "states",  bench_state, NULL, 0xe2 },
+    { "msl_run_state/e0",           "states",  bench_state, NULL, 0xe0 },
+    { "msl_run_state/e4",           "states",  bench_state, NULL, 0xe4 },
+    { "msl_run_state/64",           "states",  bench_state, NULL, 0x64 },
+    { "NO_knot",                    "calls",   bench_no_knot },
+    { "NI_knot",                    "calls",   bench_ni_knot },
+    { "NA_knot",                    "calls",   bench_na_knot },
+    { "knots/cached",               "calls",   bench_knots_cached },
+    { "ge_log/disabled",            "calls",   bench_log_disabled },
+    /* not the loader: it waits forever for cards in its own format */
+    { "program/compile-print",      "cycles",  bench_cycle, "compile-print.txt" },
+    { "program/compile-print/insn", "cycles",  bench_step,  "compile-print.txt" },
+};
+
+#define BENCHES (sizeof(benches) / sizeof(benches[0]))
+
+static int cmp_double(const void *a, const void *b)
+{
+    const double *x = a, *y = b;
+
+    return (*x > *y) - (*x < *y);
+}
+
+/**
+ * Confidence interval of the median
+ *
+ * Distribution free, from the order statistics of the sorted samples:
+ * the widest interval [x(k), x(n - 1 - k)] whose probability to contain
+ * the median, given by the binomial distribution, is at least 95%. With
+ * less than 6 samples it is the whole range.
+ */
+static void median_ci(const double *sorted, int n, double *low, double *high)
+{
+    double p = 1.0 / (1ULL << n), tail = p, c = 1;
+    int k = 0;
+
+    /* P(X <= k), X ~ B(n, 1/2), up to 2.5% */
+    for (;;) {
+        c = c * (n - k) / (k + 1);
+        if (tail + c * p > 0.025 || k + 1 >= n / 2)
+            break;
+        tail += c * p;
+        k++;
+    }
+
+    if (tail > 0.025)
+        k = 0;
+
+    *low  = sorted[k];
+    *high = sorted[n - 1 - k];
+}
+
+/* Time a run of `iterations` iterations from the initial machine */
+static double run_once(struct bench *b, uint64_t iterations, uint64_t *items)
+{
+    int64_t start;
+
+    machine = initial;
+    rewind_deck();
+    fetches = 0;
+    restart_ns = 0;
+
+    start = monotonic_ns();
+    *items = b->run(b, iterations);
+    return monotonic_ns() - start - restart_ns;
+}
+
+static int run_bench(struct bench *b, double min_time, int repetitions)
+{
+    double ns[MAX_REPETITIONS], insns[MAX_REPETITIONS];
+    uint64_t iterations = 1, items = 0;
+    double elapsed;
+    int i;
+
+    if (setup_program(b->arg) != 0)
+        return -1;
+
+    /* the warm up run sets the number of iterations */
+    do {
+        iterations *= 2;
+        elapsed = run_once(b, iterations, &items);
+    } while (elapsed < min_time * NSEC_PER_SEC && iterations < MAX_ITERATIONS);
+
+    for (i = 0; i < repetitions; i++) {
+        elapsed = run_once(b, iterations, &items);
+        if (items == 0)
+            return -1;
+
+        ns[i] = elapsed / items;
+        insns[i] = fetches * NSEC_PER_SEC / elapsed;
+    }
+
+    qsort(ns, repetitions, sizeof(double), cmp_double);
+    qsort(insns, repetitions, sizeof(double), cmp_double);
+
+    b->iterations = iterations;
+    b->ns_per_item = ns[repetitions / 2];
+    median_ci(ns, repetitions, &b->ci_low, &b->ci_high);
+    b->items_per_second = NSEC_PER_SEC / b->ns_per_item;
+    b->insns_per_second = insns[repetitions / 2];
+    return 0;
+}
+
+static void print_result(const struct bench *b)
+{
+    printf("%-28s %12.2f %14llu %12.3fM %s/s",
+           b->name, b->ns_per_item, (unsigned long long)b->iterations,
+           b->items_per_second / 1e6, b->unit);
+
+    if (b->insns_per_second > 0)
+        printf(" %10.3fM insns/s", b->insns_per_second / 1e6);
+
+    printf("\n");
+}
+
+static int write_json(const char *path, const char *revision,
+                      double min_time, int repetitions)
+{
+    char host[MAX_LINE] = "";
+    time_t now = time(NULL);
+    char date[MAX_LINE];
+    const struct bench *b;
+    int first = 1;
+    size_t i;
+    FILE *f;
+
+    f = fopen(path, "w");
+    if (f == NULL) {
+        perror(path);
+        return -1;
+    }
+
+    gethostname(host, sizeof(host) - 1);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", localtime(&now));
+
+    fprintf(f, "{\n  \"context\": {\n"
+               "    \"date\": \"%s\",\n"
+               "    \"revision\": \"%s\",\n"
+               "    \"host_name\": \"%s\",\n"
+               "    \"num_cpus\": %ld,\n"
+               "    \"min_time\": %g,\n"
+               "    \"repetitions\": %d\n"
+               "  },\n  \"benchmarks\": [",
+            date, revision, host, sysconf(_SC_NPROCESSORS_ONLN), min_time, repetitions);
+
+    for (i = 0; i < BENCHES; i++) {
+        b = &benches[i];
+        if (b->iterations == 0)
+            continue;
+
+        fprintf(f, "%s\n    {\"name\": \"%s\", \"iterations\": %llu, "
+                   "\"time_unit\": \"ns\", \"real_time\": %.3f, "
+                   "\"real_time_ci\": [%.3f, %.3f], "
+                   "\"items_per_second\": %.1f, \"unit\": \"%s\"",
+                first ? "" : ",", b->name, (unsigned long long)b->iterations,
+                b->ns_per_item, b->ci_low, b->ci_high,
+                b->items_per_second, b->unit);
+
+        if (b->insns_per_second > 0)
+            fprintf(f, ", \"insns_per_second\": %.1f", b->insns_per_second);
+
+        fprintf(f, "}");
+        first = 0;
+    }
+
+    fprintf(f, "\n  ]\n}\n");
+
+    if (fclose(f) != 0) {
+        perror(path);
+        return -1;
+    }
+
+    return 0;
+}
+
+static struct bench *find_bench(const char *name)
+{
+    size_t i;
+
+    for (i = 0; i < BENCHES; i++) {
+        if (strcmp(benches[i].name, name) == 0)
+            return &benches[i];
+    }
+
+    return NULL;
+}
+
+/* The revision of the working tree, "unknown" outside of git */
+static void git_revision(char *revision, size_t size)
+{
+    FILE *p = popen("git describe --always --dirty 2>/dev/null", "r");
+
+    snprintf(revision, size, "unknown");
+
+    if (p == NULL)
+        return;
+
+    if (fgets(revision, size, p) == NULL || revision[0] == '\n')
+        snprintf(revision, size, "unknown");
+
+    revision[strcspn(revision, "\n")] = 0;
+    pclose(p);
+}
+
+/**
+ * Read the baseline
+ *
+ * The file has a line for every benchmark run at a revision:
+ *
+ *     # revision  benchmark  median  ci-low  ci-high
+ *
+ * in ns per item. The baseline is `base` if given, otherwise the last
+ * revision of the file that is not `revision`.
+ *
+ * @return 0 on success (also if the file does not exist yet), -1 on errors
+ */
+static int read_baseline(const char *path, const char *revision,
+                         const char *base, char *found, size_t size)
+{
+    char line[MAX_LINE], rev[MAX_REVISION], name[MAX_LINE];
+    double median, low, high;
+    struct bench *b;
+    FILE *f;
+    int pass;
+
+    found[0] = 0;
+
+    f = fopen(path, "r");
+    if (f == NULL)
+        return 0;
+
+    /* find the baseline revision, then its results */
+    for (pass = 0; pass < 2; pass++) {
+        rewind(f);
+
+        while (fgets(line, sizeof(line), f)) {
+            if (line[0] == '#')
+                continue;
+
+            if (sscanf(line, "%63s %255s %lf %lf %lf", rev, name, &median, &low, &high) != 5) {
+                fprintf(stderr, "%s: invalid line: %s", path, line);
+                fclose(f);
+                return -1;
+            }
+
+            if (pass == 0) {
+                if ((base && strcmp(rev, base) == 0) ||
+                    (!base && strcmp(rev, revision) != 0))
+                    snprintf(found, size, "%s", rev);
+                continue;
+            }
+
+            b = find_bench(name);
+            if (b == NULL || strcmp(rev, found) != 0)
+                continue;
+
+            b->has_baseline = 1;
+            b->base_ns_per_item = median;
+            b->base_ci_low = low;
+            b->base_ci_high = high;
+        }
+
+        if (!found[0])
+            break;
+    }
+
+    fclose(f);
+    return 0;
+}
+
+/* Replace the results of `revision` with the ones just taken */
+static int write_baseline(const char *path, const char *revision)
+{
+    char tmp[PATH_MAX], line[MAX_LINE], rev[MAX_REVISION], name[MAX_LINE];
+    const struct bench *b;
+    FILE *in, *out;
+    size_t i;
+
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+
+    out = fopen(tmp, "w");
+    if (out == NULL) {
+        perror(tmp);
+        return -1;
+    }
+
+    fprintf(out, "# revision\tbenchmark\tmedian\tci-low\tci-high (ns per item)\n");
+
+    in = fopen(path, "r");
+    while (in && fgets(line, sizeof(line), in)) {
+        if (line[0] == '#')
+            continue;
+
+        /* the benchmarks not run this time are kept */
+        if (sscanf(line, "%63s %255s", rev, name) == 2 && strcmp(rev, revision) == 0) {
+            b = find_bench(name);
+            if (b && b->iterations)
+                continue;
+        }
+
+        fputs(line, out);
+    }
+
+    if (in)
+        fclose(in);
+
+    for (i = 0; i < BENCHES; i++) {
+        b = &benches[i];
+        if (b->iterations == 0)
+            continue;
+
+        fprintf(out, "%s\t%s\t%.3f\t%.3f\t%.3f\n",
+                revision, b->name, b->ns_per_item, b->ci_low, b->ci_high);
+    }
+
+    if (fclose(out) != 0 || rename(tmp, path) != 0) {
+        perror(path);
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * Compare the results with the baseline
+ *
+ * @return the number of benchmarks that regressed
+ */
+static int compare_baseline(const char *base, double threshold)
+{
+    const struct bench *b;
+    int regressions = 0;
+    const char *verdict;
+    double change;
+    size_t i;
+
+    printf("\nCompared with %s (threshold %.1f%%)\n", base, threshold);
+
+    for (i = 0; i < BENCHES; i++) {
+        b = &benches[i];
+        if (b->iterations == 0 || !b->has_baseline)
+            continue;
+
+        change = 100.0 * (b->ns_per_item - b->base_ns_per_item) / b->base_ns_per_item;
+
+        /* the intervals do not overlap, and the change is big enough */
+        if (change > threshold && b->ci_low > b->base_ci_high) {
+            verdict = "REGRESSION";
+            regressions++;
+        } else if (change < -threshold && b->ci_high < b->base_ci_low) {
+            verdict = "faster";
+        } else {
+            verdict = "same";
+        }
+
+        printf("%-28s %12.2f -> %12.2f %+8.1f%%  %s\n",
+               b->name, b->base_ns_per_item, b->ns_per_item, change, verdict);
+    }
+
+    return regressions;
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+            "usage: %s [-f filter] [-t min-seconds] [-r repetitions] [-s software-dir]\n"
+            "          [-j results.json] [-b baseline-file] [-R revision]\n"
+            "          [-B baseline-revision] [-T threshold-percent]\n"
+            "\n"
+            "  -f filter        only the benchmarks whose name contains filter\n"
+            "  -t seconds       minimum time of a run (default 0.2)\n"
+            "  -r repetitions   runs to take the median of (default 5)\n"
+            "  -s dir           where the listings are (default software)\n"
+            "  -j file          write the results as JSON\n"
+            "  -b file          keep the results in file, and compare them with\n"
+            "                   the ones of the last other revision there\n"
+            "  -R revision      revision of the results (default git describe)\n"
+            "  -B revision      compare with this revision instead\n"
+            "  -T percent       slow down considered a regression (default 10)\n"
+            "\n"
+            "The exit status is %d if some benchmark regressed.\n",
+            name, EXIT_REGRESSION);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *filter = NULL, *json = NULL;
+    const char *baseline = NULL, *base = NULL;
+    char revision[MAX_REVISION] = "", found[MAX_REVISION];
+    double threshold = 10;
+    double min_time = 0.2;
+    int repetitions = 5;
+    int opt, ret = 0;
+    size_t i;
+
+    while ((opt = getopt(argc, argv, "f:t:r:s:j:b:R:B:T:h")) != -1) {
+        switch (opt) {
+            case 'f': filter = optarg;                break;
+            case 't': min_time = strtod(optarg, NULL); break;
+            case 'r': repetitions = atoi(optarg);     break;
+            case 's': software_dir = optarg;          break;
+            case 'j': json = optarg;                  break;
+            case 'b': baseline = optarg;              break;
+            case 'R': snprintf(revision, sizeof(revision), "%s", optarg); break;
+            case 'B': base = optarg;                  break;
+            case 'T': threshold = strtod(optarg, NULL); break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (repetitions <= 0 || repetitions > MAX_REPETITIONS || min_time <= 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (!revision[0])
+        git_revision(revision, sizeof(revision));
+
+    if (baseline && read_baseline(baseline, revision, base, found, sizeof(found)) != 0)
+        return 1;
+
+    /* a single thread, and no logs */
+    ge_log_set_active_types(0);
+    msl_init();
+
+    printf("%-28s %12s %14s %21s\n", "Benchmark", "Time (ns)", "Iterations", "Rate");
+
+    for (i = 0; i < BENCHES; i++) {
+        if (filter && strstr(benches[i].name, filter) == NULL)
+            continue;
+
+        if (run_bench(&benches[i], min_time, repetitions) != 0) {
+            fprintf(stderr, "%s: failed\n", benches[i].name);
+            ret = 1;
+            continue;
+        }
+
+        print_result(&benches[i]);
+    }
+
+    if (json && write_json(json, revision, min_time, repetitions) != 0)
+        ret = 1;
+
+    if (baseline && found[0] && compare_baseline(found, threshold) > 0 && ret == 0)
+        ret = EXIT_REGRESSION;
+
+    if (baseline && base && !found[0])
+        fprintf(stderr, "%s: no results for revision %s\n", baseline, base);
+
+    if (baseline && write_baseline(baseline, revision) != 0)
+        ret = 1;
+
+    return ret;
+}
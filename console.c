@@ -52,6 +52,7 @@ void ge_set_console_switches(struct ge *ge, struct ge_console_switches *switches
            switches->SITE, switches->INCE, switches->INAR, switches->STOC,
            switches->ACON, switches->ACOV, switches->RICI, switches->PATE, switches->PAPA);
     ge->console_switches = *switches;
+    NO_changed(ge);
 }
 
 
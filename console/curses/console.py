@@ -54,10 +54,24 @@ button_pins = [
         ]
 
 
+# Console protocol, see console_socket.h
+PROTOCOL_VERSION = 1
+MSG_SUBSCRIBE = 1
+MSG_UNSUBSCRIBE = 2
+MSG_SWITCHES = 3
+MSG_ROTARY = 4
+MSG_BUTTONS = 5
+MSG_UPDATE = 6
+STATE_WORDS = 9
+UPDATE_INTERVAL = 20 # ms
+CPU_PATH = sys.argv[1] if len(sys.argv) > 1 else "/tmp/gemu.console"
+RESUBSCRIBE = 5 # s without updates
+
 MS_VAL = 0
 AM_VAL = 0
 BUTTONS_VAL = 0
 ROT_VAL = 9 # RS_NORM
+CONTROLS_CHANGED = False
 
 LP_RO = 0
 LP_SO = 0
@@ -67,7 +81,9 @@ LP_OP_REG = 0
 LP_ALERTS = 0
 SCREEN = 'top'
 CPU_sock = None
-CPU_sock_connected = False
+CPU_words = [0] * STATE_WORDS
+CPU_seq = None
+CPU_last_update = 0
 
 
 scr = curses.initscr()
@@ -135,16 +151,35 @@ def statusbar(st):
     else:
         scr.addstr(MAX_Y - 2, x, "Diagnostic panel. Press [TAB] to switch.", curses.color_pair(cp))
 
+# Apply an update, only the words in its mask are sent.
+# Returns False if an update was lost
 def CPU_read_status(buf):
     global LP_RO, LP_SO, LP_SA
     global LP_ADD_REG, LP_OP_REG, LP_ALERTS
-    statusbar('msg')
-    if (len(buf) != 19):
+    global MS_VAL, AM_VAL, ROT_VAL
+    global CPU_seq
+    if len(buf) < 6:
+        statusbar('protocol error')
+        return True
+    version, msg_type, seq, mask = struct.unpack("BBHH", buf[0:6])
+    if version != PROTOCOL_VERSION or msg_type != MSG_UPDATE:
         statusbar('protocol error')
-        return
-    LP_RO, LP_SO, LP_SA = struct.unpack("HHH", buf[0:6])
-    LP_ADD_REG, LP_OP_REG, LP_ALERTS = struct.unpack("HHH", buf[6:12])
+        return True
+    if mask != (1 << STATE_WORDS) - 1 and seq != CPU_seq:
+        return False
+    CPU_seq = (seq + 1) & 0xffff
+    pos = 6
+    for i in range(0, STATE_WORDS):
+        if mask & (1 << i):
+            CPU_words[i], = struct.unpack("H", buf[pos:pos + 2])
+            pos += 2
+    LP_RO, LP_SO, LP_SA, LP_ADD_REG, LP_OP_REG, LP_ALERTS = CPU_words[0:6]
+    if not CONTROLS_CHANGED:
+        MS_VAL = CPU_words[6] & 0x1ff
+        AM_VAL = CPU_words[7]
+        ROT_VAL = CPU_words[8]
     statusbar('CPU Synchronized')
+    return True
 
 def switch_screen():
     global SCREEN
@@ -384,6 +419,7 @@ def parse_mouse(i, y, x):
     global BUTTONS_VAL
     global SCREEN
     global ROT_VAL
+    global CONTROLS_CHANGED
     if (SCREEN == 'top'):
         # Temporary rotor
         #
@@ -391,11 +427,13 @@ def parse_mouse(i, y, x):
             ROT_VAL -= 1
             if (ROT_VAL < 0):
                 ROT_VAL = 0
+            CONTROLS_CHANGED = True
             return
         if (y > 28) and (y < 32)  and (x > 120) and (x < 130):
             ROT_VAL += 1
             if (ROT_VAL > 13):
                 ROT_VAL = 13
+            CONTROLS_CHANGED = True
             return
         # End temp rotor
         x0 = 90
@@ -425,12 +463,14 @@ def parse_mouse(i, y, x):
                 AM_VAL |= (1 << bp)
             else:
                 AM_VAL &= ~(1 << bp)
+            CONTROLS_CHANGED = True
             return
         bp = 8 - pos
         if (MS_VAL & (1 << bp)) == 0:
             MS_VAL |= (1 << bp)
         else:
             MS_VAL &= ~(1 << bp)
+        CONTROLS_CHANGED = True
 
     elif SCREEN == 'front':
         if (y < 14) or (y > 22):
@@ -450,12 +490,17 @@ def parse_mouse(i, y, x):
         BUTTONS_VAL |= (1 << button_pressed)
 
 
+def CPU_send(msg_type, payload=b''):
+    CPU_sock.send(struct.pack("BBH", PROTOCOL_VERSION, msg_type, 0) + payload)
+
 def comm_cpu():
-    global CPU_sock;
-    global CPU_sock_connected;
+    global CPU_sock
+    global CPU_seq, CPU_last_update
     global MS_VAL, AM_VAL, BUTTONS_VAL, ROT_VAL
+    global CONTROLS_CHANGED
     if CPU_sock is None:
-        sockname = "/tmp/gemu.console.client"
+        # one socket per console, many consoles can attach to a CPU
+        sockname = "/tmp/gemu.console.client.%d" % os.getpid()
         CPU_sock = socket.socket(socket.AF_UNIX, socket.SOCK_DGRAM)
         CPU_sock.setblocking(False)
         try:
@@ -464,33 +509,43 @@ def comm_cpu():
             pass
         CPU_sock.bind(sockname)
         statusbar("CPU socket created.")
-    if CPU_sock_connected == False:
+
+    # subscribe once, again if the CPU was restarted or an update lost
+    if CPU_seq is None or time.time() - CPU_last_update > RESUBSCRIBE:
         statusbar("Connecting to CPU...")
+        CPU_last_update = time.time()
         try:
-            CPU_sock.connect("/tmp/gemu.console")
+            CPU_sock.connect(CPU_PATH)
+            CPU_send(MSG_SUBSCRIBE, struct.pack("H", UPDATE_INTERVAL))
+            CPU_seq = 0
         except:
+            CPU_seq = None
             return False
-    CPU_sock_connected == True
-    statusbar("Connected to CPU.")
-    try:
-        CPU_sock.send(struct.pack("HHHHHHHHHb",
-            0, 0, 0,  # Console lamps, do not set
-            0, 0, 0,  # Front panel lamps
-            MS_VAL, AM_VAL, # Switches
-            BUTTONS_VAL,
-            ROT_VAL))
 
-    except:
-        pass
     try:
-        r = CPU_sock.recv(1024)
-        if r != None:
-            CPU_read_status(r)
-            return True
+        if CONTROLS_CHANGED:
+            CPU_send(MSG_SWITCHES, struct.pack("HH", MS_VAL, AM_VAL))
+            CPU_send(MSG_ROTARY, struct.pack("H", ROT_VAL))
+            CONTROLS_CHANGED = False
+        if BUTTONS_VAL:
+            CPU_send(MSG_BUTTONS, struct.pack("H", BUTTONS_VAL))
+            BUTTONS_VAL = 0
     except:
+        CPU_seq = None
         return False
-    return False
 
+    updated = False
+    while True:
+        try:
+            r = CPU_sock.recv(1024)
+        except:
+            break
+        CPU_last_update = time.time()
+        if not CPU_read_status(r):
+            CPU_seq = None
+            break
+        updated = True
+    return updated
 
 
 # Curses wrapped function
@@ -15,104 +15,177 @@ struct ge* ge = &ge130;
 
 int running_loop = 0;
 
-EM_JS(void, set_lamp, (const char *lamp, int val), {
-    document.set_lamp(UTF8ToString(lamp), val);
+/*
+ * Time given to the emulation in every frame, in ms, see set_frame_budget().
+ * The worker build (GE_WORKER, see worker.mjs) does not share the thread
+ * with the page, so it can take most of the frame.
+ */
+#ifdef GE_WORKER
+#define FRAME_BUDGET_MS 15.0
+#else
+#define FRAME_BUDGET_MS 8.0
+#endif
+
+/* The clock is looked at about this often while running a frame, the
+ * cycles run in between are adapted to the speed of the host */
+#define CLOCK_CHECK_MS 0.5
+
+static double frame_budget_ms = FRAME_BUDGET_MS;
+static uint32_t cycles_per_check = 64;
+
+/*
+ * The lamps of the console, X(name, value of struct ge_console *c): the
+ * name is the id of the lamp in console.html, without the "l_" prefix.
+ */
+#define ENUMERATE_LAMPS \
+    X("RO_0",           BIT(c->lamps.RO, 0))                 \
+    X("RO_1",           BIT(c->lamps.RO, 1))                 \
+    X("RO_2",           BIT(c->lamps.RO, 2))                 \
+    X("RO_3",           BIT(c->lamps.RO, 3))                 \
+    X("RO_4",           BIT(c->lamps.RO, 4))                 \
+    X("RO_5",           BIT(c->lamps.RO, 5))                 \
+    X("RO_6",           BIT(c->lamps.RO, 6))                 \
+    X("RO_7",           BIT(c->lamps.RO, 7))                 \
+    X("RO_8",           BIT(c->lamps.RO, 8))                 \
+    X("SO_0",           BIT(c->lamps.SO, 0))                 \
+    X("SO_1",           BIT(c->lamps.SO, 1))                 \
+    X("SO_2",           BIT(c->lamps.SO, 2))                 \
+    X("SO_3",           BIT(c->lamps.SO, 3))                 \
+    X("SO_4",           BIT(c->lamps.SO, 4))                 \
+    X("SO_5",           BIT(c->lamps.SO, 5))                 \
+    X("SO_6",           BIT(c->lamps.SO, 6))                 \
+    X("SO_7",           BIT(c->lamps.SO, 7))                 \
+    X("FA_0",           BIT(c->lamps.FA, 0))                 \
+    X("FA_1",           BIT(c->lamps.FA, 1))                 \
+    X("FA_2",           BIT(c->lamps.FA, 2))                 \
+    X("FA_3",           BIT(c->lamps.FA, 3))                 \
+    X("SA_0",           BIT(c->lamps.SA, 0))                 \
+    X("SA_1",           BIT(c->lamps.SA, 1))                 \
+    X("SA_2",           BIT(c->lamps.SA, 2))                 \
+    X("SA_3",           BIT(c->lamps.SA, 3))                 \
+    X("SA_4",           BIT(c->lamps.SA, 4))                 \
+    X("SA_5",           BIT(c->lamps.SA, 5))                 \
+    X("SA_6",           BIT(c->lamps.SA, 6))                 \
+    X("SA_7",           BIT(c->lamps.SA, 7))                 \
+    X("B_0",            BIT(c->lamps.B, 0))                  \
+    X("B_1",            BIT(c->lamps.B, 1))                  \
+    X("B_2",            BIT(c->lamps.B, 2))                  \
+    X("B_3",            BIT(c->lamps.B, 3))                  \
+    X("ADD_0",          BIT(c->lamps.ADD_reg, 0))            \
+    X("ADD_1",          BIT(c->lamps.ADD_reg, 1))            \
+    X("ADD_2",          BIT(c->lamps.ADD_reg, 2))            \
+    X("ADD_3",          BIT(c->lamps.ADD_reg, 3))            \
+    X("ADD_4",          BIT(c->lamps.ADD_reg, 4))            \
+    X("ADD_5",          BIT(c->lamps.ADD_reg, 5))            \
+    X("ADD_6",          BIT(c->lamps.ADD_reg, 6))            \
+    X("ADD_7",          BIT(c->lamps.ADD_reg, 7))            \
+    X("ADD_8",          BIT(c->lamps.ADD_reg, 8))            \
+    X("ADD_9",          BIT(c->lamps.ADD_reg, 9))            \
+    X("ADD_A",          BIT(c->lamps.ADD_reg, 10))           \
+    X("ADD_B",          BIT(c->lamps.ADD_reg, 11))           \
+    X("ADD_C",          BIT(c->lamps.ADD_reg, 12))           \
+    X("ADD_D",          BIT(c->lamps.ADD_reg, 13))           \
+    X("ADD_E",          BIT(c->lamps.ADD_reg, 14))           \
+    X("ADD_F",          BIT(c->lamps.ADD_reg, 15))           \
+    X("OP_0",           BIT(c->lamps.OP_reg, 0))             \
+    X("OP_1",           BIT(c->lamps.OP_reg, 1))             \
+    X("OP_2",           BIT(c->lamps.OP_reg, 2))             \
+    X("OP_3",           BIT(c->lamps.OP_reg, 3))             \
+    X("OP_4",           BIT(c->lamps.OP_reg, 4))             \
+    X("OP_5",           BIT(c->lamps.OP_reg, 5))             \
+    X("OP_6",           BIT(c->lamps.OP_reg, 6))             \
+    X("OP_7",           BIT(c->lamps.OP_reg, 7))             \
+    X("UR",             c->lamps.UR)                         \
+    X("C3",             c->lamps.C3)                         \
+    X("C2",             c->lamps.C2)                         \
+    X("C1",             c->lamps.C1)                         \
+    X("I",              c->lamps.I)                          \
+    X("JE",             c->lamps.JE)                         \
+    X("IM",             c->lamps.IM)                         \
+    X("NZ",             c->lamps.NZ)                         \
+    X("OF",             c->lamps.OF)                         \
+    X("DC_ALERT",       c->lamps.DC_ALERT)                   \
+    X("POWER_OFF",      c->lamps.POWER_OFF)                  \
+    X("STAND_BY",       c->lamps.STAND_BY)                   \
+    X("POWER_ON",       c->lamps.POWER_ON && running_loop)   \
+    X("MAINTENANCE_ON", c->lamps.MAINTENANCE_ON)             \
+    X("MEM_CHECK",      c->lamps.MEM_CHECK)                  \
+    X("INV_ADD",        c->lamps.INV_ADD)                    \
+    X("SWITCH_1",       c->lamps.SWITCH_1)                   \
+    X("SWITCH_2",       c->lamps.SWITCH_2)                   \
+    X("STEP_BY_STEP",   c->lamps.STEP_BY_STEP)               \
+    X("HALT",           c->lamps.HALT)                       \
+    X("LOAD_1",         c->lamps.LOAD_1)                     \
+    X("LOAD_2",         c->lamps.LOAD_2)                     \
+    X("OPERATOR_CALL",  c->lamps.OPERATOR_CALL)
+
+enum {
+#define X(name, value) 1 +
+    LAMPS_COUNT = ENUMERATE_LAMPS 0
+#undef X
+};
+
+static const char *lamp_names[LAMPS_COUNT] = {
+#define X(name, value) name,
+    ENUMERATE_LAMPS
+#undef X
+};
+
+/* The state of every lamp, one byte each, read by console.html straight
+ * from the memory of the module */
+static uint8_t lamps[LAMPS_COUNT];
+
+#ifndef GE_WORKER
+
+/* The names are decoded once, the lamps are then known by index */
+EM_JS(void, set_lamp_names, (const char **names, int count), {
+    const list = [];
+    for (let i = 0; i < count; i++)
+        list.push(UTF8ToString(HEAPU32[(names >> 2) + i]));
+    document.set_lamp_names(list);
+});
+
+/* A single call per update: console.html compares the lamps with the
+ * ones it has shown, and only changes those that differ */
+EM_JS(void, update_lamps, (const uint8_t *lamps, int count), {
+    document.update_lamps(HEAPU8.subarray(lamps, lamps + count));
+});
+
+#else
+
+/* The lamps are copied in a SharedArrayBuffer, which the page reads on
+ * its own animation frames: a sequence number (Int32) followed by a
+ * byte per lamp. The names and the buffer are posted once. */
+EM_JS(void, set_lamp_names, (const char **names, int count), {
+    const list = [];
+    for (let i = 0; i < count; i++)
+        list.push(UTF8ToString(HEAPU32[(names >> 2) + i]));
+
+    const shared = new SharedArrayBuffer(4 + count);
+    globalThis.ge_lamps_seq = new Int32Array(shared, 0, 1);
+    globalThis.ge_lamps = new Uint8Array(shared, 4, count);
+    postMessage({ lamp_names: list, lamps: shared });
 });
 
+EM_JS(void, update_lamps, (const uint8_t *lamps, int count), {
+    globalThis.ge_lamps.set(HEAPU8.subarray(lamps, lamps + count));
+    Atomics.add(globalThis.ge_lamps_seq, 0, 1);
+});
+
+#endif
+
 void send_console() {
     struct ge_console console;
-    int r = running_loop;
-
-    ge_fill_console_data(ge, &console);
-
-    set_lamp("RO_0", BIT(console.lamps.RO, 0));
-    set_lamp("RO_1", BIT(console.lamps.RO, 1));
-    set_lamp("RO_2", BIT(console.lamps.RO, 2));
-    set_lamp("RO_3", BIT(console.lamps.RO, 3));
-    set_lamp("RO_4", BIT(console.lamps.RO, 4));
-    set_lamp("RO_5", BIT(console.lamps.RO, 5));
-    set_lamp("RO_6", BIT(console.lamps.RO, 6));
-    set_lamp("RO_7", BIT(console.lamps.RO, 7));
-    set_lamp("RO_8", BIT(console.lamps.RO, 8));
-
-    set_lamp("SO_0", BIT(console.lamps.SO, 0));
-    set_lamp("SO_1", BIT(console.lamps.SO, 1));
-    set_lamp("SO_2", BIT(console.lamps.SO, 2));
-    set_lamp("SO_3", BIT(console.lamps.SO, 3));
-    set_lamp("SO_4", BIT(console.lamps.SO, 4));
-    set_lamp("SO_5", BIT(console.lamps.SO, 5));
-    set_lamp("SO_6", BIT(console.lamps.SO, 6));
-    set_lamp("SO_7", BIT(console.lamps.SO, 7));
-
-    set_lamp("FA_0", BIT(console.lamps.FA, 0));
-    set_lamp("FA_1", BIT(console.lamps.FA, 1));
-    set_lamp("FA_2", BIT(console.lamps.FA, 2));
-    set_lamp("FA_3", BIT(console.lamps.FA, 3));
-
-    set_lamp("SA_0", BIT(console.lamps.SA, 0));
-    set_lamp("SA_1", BIT(console.lamps.SA, 1));
-    set_lamp("SA_2", BIT(console.lamps.SA, 2));
-    set_lamp("SA_3", BIT(console.lamps.SA, 3));
-    set_lamp("SA_4", BIT(console.lamps.SA, 4));
-    set_lamp("SA_5", BIT(console.lamps.SA, 5));
-    set_lamp("SA_6", BIT(console.lamps.SA, 6));
-    set_lamp("SA_7", BIT(console.lamps.SA, 7));
-
-    set_lamp("B_0", BIT(console.lamps.B, 0));
-    set_lamp("B_1", BIT(console.lamps.B, 1));
-    set_lamp("B_2", BIT(console.lamps.B, 2));
-    set_lamp("B_3", BIT(console.lamps.B, 3));
-
-    set_lamp("ADD_0", BIT(console.lamps.ADD_reg,  0));
-    set_lamp("ADD_1", BIT(console.lamps.ADD_reg,  1));
-    set_lamp("ADD_2", BIT(console.lamps.ADD_reg,  2));
-    set_lamp("ADD_3", BIT(console.lamps.ADD_reg,  3));
-    set_lamp("ADD_4", BIT(console.lamps.ADD_reg,  4));
-    set_lamp("ADD_5", BIT(console.lamps.ADD_reg,  5));
-    set_lamp("ADD_6", BIT(console.lamps.ADD_reg,  6));
-    set_lamp("ADD_7", BIT(console.lamps.ADD_reg,  7));
-    set_lamp("ADD_8", BIT(console.lamps.ADD_reg,  8));
-    set_lamp("ADD_9", BIT(console.lamps.ADD_reg,  9));
-    set_lamp("ADD_A", BIT(console.lamps.ADD_reg, 10));
-    set_lamp("ADD_B", BIT(console.lamps.ADD_reg, 11));
-    set_lamp("ADD_C", BIT(console.lamps.ADD_reg, 12));
-    set_lamp("ADD_D", BIT(console.lamps.ADD_reg, 13));
-    set_lamp("ADD_E", BIT(console.lamps.ADD_reg, 14));
-    set_lamp("ADD_F", BIT(console.lamps.ADD_reg, 15));
-
-    set_lamp("OP_0", BIT(console.lamps.OP_reg, 0));
-    set_lamp("OP_1", BIT(console.lamps.OP_reg, 1));
-    set_lamp("OP_2", BIT(console.lamps.OP_reg, 2));
-    set_lamp("OP_3", BIT(console.lamps.OP_reg, 3));
-    set_lamp("OP_4", BIT(console.lamps.OP_reg, 4));
-    set_lamp("OP_5", BIT(console.lamps.OP_reg, 5));
-    set_lamp("OP_6", BIT(console.lamps.OP_reg, 6));
-    set_lamp("OP_7", BIT(console.lamps.OP_reg, 7));
-
-    set_lamp("UR",  console.lamps.UR);
-    set_lamp("C3",  console.lamps.C3);
-    set_lamp("C2",  console.lamps.C2);
-    set_lamp("C1",  console.lamps.C1);
-    set_lamp("I",   console.lamps.I );
-    set_lamp("JE",  console.lamps.JE);
-    set_lamp("IM",  console.lamps.IM);
-    set_lamp("NZ",  console.lamps.NZ);
-    set_lamp("OF",  console.lamps.OF);
-
-    set_lamp("DC_ALERT",       console.lamps.DC_ALERT      );
-    set_lamp("POWER_OFF",      console.lamps.POWER_OFF     );
-    set_lamp("STAND_BY",       console.lamps.STAND_BY      );
-    set_lamp("POWER_ON",       console.lamps.POWER_ON && r );
-    set_lamp("MAINTENANCE_ON", console.lamps.MAINTENANCE_ON);
-    set_lamp("MEM_CHECK",      console.lamps.MEM_CHECK     );
-    set_lamp("INV_ADD",        console.lamps.INV_ADD       );
-    set_lamp("SWITCH_1",       console.lamps.SWITCH_1      );
-    set_lamp("SWITCH_2",       console.lamps.SWITCH_2      );
-    set_lamp("STEP_BY_STEP",   console.lamps.STEP_BY_STEP  );
-    set_lamp("HALT",           console.lamps.HALT          );
-    set_lamp("LOAD_1",         console.lamps.LOAD_1        );
-    set_lamp("LOAD_2",         console.lamps.LOAD_2        );
-    set_lamp("OPERATOR_CALL",  console.lamps.OPERATOR_CALL );
+    struct ge_console *c = &console;
+    int i = 0;
+
+    ge_fill_console_data(ge, c);
+
+#define X(name, value) lamps[i++] = (value) ? 1 : 0;
+    ENUMERATE_LAMPS
+#undef X
+
+    update_lamps(lamps, LAMPS_COUNT);
 }
 
 
@@ -144,22 +217,57 @@ void EMSCRIPTEN_KEEPALIVE set_register_selector(int s) {
     send_console();
 }
 
+/** Time given to the emulation in every frame, in ms */
+void EMSCRIPTEN_KEEPALIVE set_frame_budget(double ms) {
+    if (ms > 0)
+        frame_budget_ms = ms;
+}
+
+/* Run as many cycles as fit in the frame budget, then update the lamps
+ * once */
 void em_main_loop() {
-    if (!running_loop) 
+    double start, now;
+    uint64_t cycles = 0;
+    uint32_t i;
+    int r = 0;
+
+    if (!running_loop)
         return;
-    
-    ge_run_cycle(ge);
+
+    start = emscripten_get_now();
+
+    do {
+        for (i = 0; i < cycles_per_check && r == 0 && !ge->halted; i++)
+            r = ge_run_cycle(ge);
+
+        cycles += i;
+        now = emscripten_get_now();
+    } while (now - start < frame_budget_ms && r == 0 && !ge->halted);
+
+    /* look at the clock about every CLOCK_CHECK_MS next time */
+    if (now > start && cycles > 0) {
+        cycles = cycles * CLOCK_CHECK_MS / (now - start);
+        cycles_per_check = cycles < 16 ? 16 : cycles > 65536 ? 65536 : cycles;
+    }
+
     send_console();
 }
 
 int main() {
-    ge_log_set_active_types(~(LOG_REGS_V | LOG_CONDS));
+    /* the log box of the page cannot keep up with the traces */
+    ge_log_set_active_types(LOG_ERR | LOG_CONSOLE);
     ge_init(ge);
 
+    set_lamp_names(lamp_names, LAMPS_COUNT);
     send_console();
 
-    /* run the main loop at 1Hz, just for show */
-    emscripten_set_main_loop(em_main_loop, 1, 0);
+#ifdef GE_WORKER
+    /* no animation frames in a worker, a frame every 16ms */
+    emscripten_set_main_loop(em_main_loop, 60, 0);
+#else
+    /* once per frame of the browser */
+    emscripten_set_main_loop(em_main_loop, 0, 0);
+#endif
     return 0;
 }
 
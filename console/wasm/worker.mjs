@@ -0,0 +1,25 @@
+// Runs the emulator (main.c built with GE_WORKER, see the Makefile) off
+// the main thread of the page.
+//
+// The page posts { call: name, args: [...] } to call the exported
+// functions of the module (press_on, set_switches, ...), the worker
+// posts back { log: text } for the output of the emulator, and once
+// { lamp_names, lamps } with the SharedArrayBuffer the lamps are kept in
+// (see update_lamps in main.c).
+
+import { default as GE_Module } from './main-worker.mjs'
+
+const pending = []
+let module
+
+onmessage = e => {
+    if (module) module['_' + e.data.call](...(e.data.args || []))
+    else pending.push(e.data)
+}
+
+GE_Module({ print: text => postMessage({ log: text }) })
+    .then(m => {
+        module = m
+        pending.forEach(d => module['_' + d.call](...(d.args || [])))
+        postMessage({ log: "ok." })
+    })
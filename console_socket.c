@@ -1,5 +1,12 @@
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <sys/socket.h>
+#include <sys/stat.h>
 #include <sys/un.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <string.h>
@@ -9,68 +16,582 @@
 #include "ge.h"
 #include "console.h"
 #include "log.h"
+#include "signals.h"
 
-static const char socket_path[] = "/tmp/gemu.console";
-static int console_socket_fd = -1;
+/* Size of the queue of the commands sent by the consoles */
+#define CONSOLE_SOCKET_QUEUE 64
+
+/* Consoles subscribed at the same time */
+#define CONSOLE_SOCKET_CLIENTS 256
+
+/* A console that cannot receive for this long is unsubscribed, ms */
+#define CONSOLE_CLIENT_TIMEOUT 5000
+
+/* Largest message: the header, the mask and all the words */
+#define CONSOLE_MSG_MAX \
+    (sizeof(struct console_msg) + sizeof(uint16_t) * (1 + CONSOLE_STATE_WORDS))
+
+/**
+ * Console command
+ *
+ * A change of the console controls sent by a console.
+ */
+struct console_command {
+    enum console_msg_type type; ///< SWITCHES, ROTARY or BUTTONS
+    union {
+        struct ge_console_switches switches;
+        enum ge_console_rotary rotary;
+        struct ge_console_buttons buttons;
+    };
+};
+
+/// Subscribed console, owned by the thread
+struct console_client {
+    struct sockaddr_un addr;
+    socklen_t addr_len;
+    uint16_t interval; ///< Milliseconds between the updates
+    uint16_t seq;      ///< Number of the next update
+    uint8_t synced;    ///< `words` have been sent
+    uint64_t due;      ///< Time of the next update, in milliseconds
+    uint64_t stalled;  ///< Since when it cannot receive, 0 if it can
+    uint16_t words[CONSOLE_STATE_WORDS];
+};
+
+/**
+ * Console socket
+ *
+ * The socket is serviced by its own thread. The emulator publishes the
+ * console state once per cycle with a seqlock, while some console is
+ * subscribed, and applies the commands queued by the thread at the
+ * beginning of the next cycle.
+ *
+ * The thread never blocks on a console: the updates a console cannot
+ * receive are merged in its next one, so that the emulator and the
+ * other consoles do not wait for it.
+ */
+struct console_socket {
+    struct ge_peri peri;
+    char path[sizeof(((struct sockaddr_un *)0)->sun_path)];
+    int fd;
+    int stop_fd;   ///< eventfd used to stop the thread
+    pthread_t thread;
+    uint8_t running;
+    dev_t dev;     ///< Of the socket bound, to remove only our own
+    ino_t ino;
+    ge_log_type log_types; ///< Of the thread that registered the socket
+
+    /* console state, written by the emulator */
+    atomic_uint seq;  ///< Odd while `console` is being written
+    struct ge_console console;
+    atomic_uint subscribed; ///< Consoles subscribed
+
+    /* commands queue, from the thread to the emulator */
+    struct console_command queue[CONSOLE_SOCKET_QUEUE];
+    atomic_uint head;
+    atomic_uint tail;
+
+    /* owned by the thread */
+    struct console_client *clients;
+    unsigned nclients;
+    unsigned size; ///< Of `clients`
+};
+
+static uint64_t now_ms(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static void console_socket_publish(struct console_socket *cs, struct ge *ge)
+{
+    unsigned seq = atomic_load_explicit(&cs->seq, memory_order_relaxed);
+
+    atomic_store_explicit(&cs->seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    ge_fill_console_data(ge, &cs->console);
+
+    atomic_store_explicit(&cs->seq, seq + 2, memory_order_release);
+}
+
+static void console_socket_read(struct console_socket *cs, struct ge_console *console)
+{
+    unsigned seq;
+
+    do {
+        seq = atomic_load_explicit(&cs->seq, memory_order_acquire);
+        memcpy(console, &cs->console, sizeof(*console));
+        atomic_thread_fence(memory_order_acquire);
+    } while ((seq & 1) || seq != atomic_load_explicit(&cs->seq, memory_order_relaxed));
+}
+
+/* The console state, as the words of the updates */
+static void console_socket_words(struct console_socket *cs, uint16_t *words)
+{
+    struct ge_console console;
+
+    console_socket_read(cs, &console);
+
+    memcpy(words + CONSOLE_STATE_LAMPS, &console.lamps, sizeof(console.lamps));
+    memcpy(words + CONSOLE_STATE_SWITCHES, &console.switches, sizeof(console.switches));
+    words[CONSOLE_STATE_ROTARY] = console.rotary;
+}
+
+static void console_socket_queue(struct console_socket *cs, struct console_command *cmd)
+{
+    unsigned head = atomic_load_explicit(&cs->head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&cs->tail, memory_order_acquire);
+
+    if (head - tail == CONSOLE_SOCKET_QUEUE) {
+        ge_log(LOG_ERR, "%s: queue full, dropping command\n", cs->path);
+        return;
+    }
+
+    cs->queue[head % CONSOLE_SOCKET_QUEUE] = *cmd;
+    atomic_store_explicit(&cs->head, head + 1, memory_order_release);
+}
+
+static struct console_client *console_socket_find(struct console_socket *cs,
+                                                  struct sockaddr_un *addr,
+                                                  socklen_t addr_len)
+{
+    unsigned i;
+
+    for (i = 0; i < cs->nclients; i++) {
+        if (cs->clients[i].addr_len == addr_len &&
+            memcmp(&cs->clients[i].addr, addr, addr_len) == 0)
+            return &cs->clients[i];
+    }
+
+    return NULL;
+}
+
+static void console_socket_unsubscribe(struct console_socket *cs,
+                                       struct console_client *client)
+{
+    *client = cs->clients[--cs->nclients];
+    atomic_store_explicit(&cs->subscribed, cs->nclients, memory_order_relaxed);
+}
+
+/* Subscribe a console, a console already subscribed starts over with
+ * all the words */
+static void console_socket_subscribe(struct console_socket *cs,
+                                     struct sockaddr_un *addr, socklen_t addr_len,
+                                     uint16_t interval)
+{
+    struct console_client *client = console_socket_find(cs, addr, addr_len);
+
+    if (client == NULL) {
+        if (cs->nclients == CONSOLE_SOCKET_CLIENTS) {
+            ge_log(LOG_ERR, "%s: too many consoles\n", cs->path);
+            return;
+        }
+
+        if (cs->nclients == cs->size) {
+            unsigned size = cs->size ? 2 * cs->size : 8;
+            struct console_client *clients = realloc(cs->clients, size * sizeof(*clients));
+
+            if (clients == NULL)
+                return;
+
+            cs->clients = clients;
+            cs->size = size;
+        }
+
+        client = &cs->clients[cs->nclients++];
+        memcpy(&client->addr, addr, addr_len);
+        client->addr_len = addr_len;
+        client->seq = 0;
+        atomic_store_explicit(&cs->subscribed, cs->nclients, memory_order_relaxed);
+    }
+
+    if (interval == 0)
+        interval = CONSOLE_INTERVAL_DEFAULT;
+    if (interval < CONSOLE_INTERVAL_MIN)
+        interval = CONSOLE_INTERVAL_MIN;
+
+    client->interval = interval;
+    client->synced = 0;
+    client->due = 0;
+    client->stalled = 0;
+
+    ge_log(LOG_CONSOLE, "console subscribed, every %u ms\n", interval);
+}
+
+static void console_socket_message(struct console_socket *cs, const uint8_t *buf, ssize_t size,
+                                   struct sockaddr_un *addr, socklen_t addr_len)
+{
+    const struct console_msg *msg = (const struct console_msg *)buf;
+    const uint8_t *payload = buf + sizeof(*msg);
+    size_t length = size - sizeof(*msg);
+    struct console_command cmd = { 0 };
+    struct console_client *client;
+    uint16_t value = 0;
+
+    if (size < (ssize_t)sizeof(*msg) || msg->version != CONSOLE_PROTOCOL_VERSION) {
+        ge_log(LOG_CONSOLE, "%s: unknown message\n", cs->path);
+        return;
+    }
+
+    if (length >= sizeof(value))
+        memcpy(&value, payload, sizeof(value));
+
+    switch (msg->type) {
+        case CONSOLE_MSG_SUBSCRIBE:
+            console_socket_subscribe(cs, addr, addr_len, value);
+            return;
+
+        case CONSOLE_MSG_UNSUBSCRIBE:
+            client = console_socket_find(cs, addr, addr_len);
+            if (client != NULL)
+                console_socket_unsubscribe(cs, client);
+            return;
+
+        case CONSOLE_MSG_SWITCHES:
+            if (length < sizeof(cmd.switches))
+                return;
+            memcpy(&cmd.switches, payload, sizeof(cmd.switches));
+            break;
+
+        case CONSOLE_MSG_ROTARY:
+            if (length < sizeof(value) || value > RS_FO)
+                return;
+            cmd.rotary = value;
+            break;
+
+        case CONSOLE_MSG_BUTTONS:
+            if (length < sizeof(cmd.buttons))
+                return;
+            memcpy(&cmd.buttons, payload, sizeof(cmd.buttons));
+            break;
+
+        default:
+            ge_log(LOG_CONSOLE, "%s: unknown message type %u\n", cs->path, msg->type);
+            return;
+    }
+
+    cmd.type = msg->type;
+    console_socket_queue(cs, &cmd);
+}
+
+/* Up to a queue of messages at once, so that the updates are sent on
+ * time even when the consoles flood the socket */
+static void console_socket_serve(struct console_socket *cs)
+{
+    uint8_t buf[1024];
+    struct sockaddr_un addr;
+    socklen_t addr_len = sizeof(addr);
+    ssize_t ret;
+    int n;
+
+    for (n = 0; n < CONSOLE_SOCKET_QUEUE; n++) {
+        ret = recvfrom(cs->fd, buf, sizeof(buf), 0, (struct sockaddr *)&addr, &addr_len);
+        if (ret <= 0)
+            break;
+
+        console_socket_message(cs, buf, ret, &addr, addr_len);
+        addr_len = sizeof(addr);
+    }
+}
+
+/* Send the words changed since the last update to `client`, returns -1
+ * if the console is gone */
+static int console_socket_update(struct console_socket *cs, struct console_client *client,
+                                 const uint16_t *words, uint64_t now)
+{
+    uint8_t buf[CONSOLE_MSG_MAX];
+    struct console_msg msg = {
+        .version = CONSOLE_PROTOCOL_VERSION,
+        .type = CONSOLE_MSG_UPDATE,
+        .seq = client->seq,
+    };
+    size_t size = sizeof(msg) + sizeof(uint16_t);
+    uint16_t mask = 0;
+    int i;
+
+    for (i = 0; i < CONSOLE_STATE_WORDS; i++) {
+        if (client->synced && words[i] == client->words[i])
+            continue;
+
+        mask |= 1 << i;
+        memcpy(buf + size, &words[i], sizeof(words[i]));
+        size += sizeof(words[i]);
+    }
+
+    if (mask == 0)
+        return 0;
+
+    memcpy(buf, &msg, sizeof(msg));
+    memcpy(buf + sizeof(msg), &mask, sizeof(mask));
+
+    if (sendto(cs->fd, buf, size, 0, (struct sockaddr *)&client->addr, client->addr_len) < 0) {
+        /* the console is not keeping up, retry at the next interval */
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS) {
+            if (client->stalled == 0)
+                client->stalled = now;
+            if (now - client->stalled < CONSOLE_CLIENT_TIMEOUT)
+                return 0;
+        }
+
+        ge_log(LOG_CONSOLE, "%s: console gone: %s\n", cs->path, strerror(errno));
+        return -1;
+    }
+
+    memcpy(client->words, words, sizeof(client->words));
+    client->synced = 1;
+    client->stalled = 0;
+    client->seq++;
+    return 0;
+}
+
+/* Update the consoles that are due, returns the milliseconds to wait
+ * for the next one, -1 if none is subscribed */
+static int console_socket_push(struct console_socket *cs)
+{
+    uint16_t words[CONSOLE_STATE_WORDS];
+    uint64_t now, next = UINT64_MAX;
+    unsigned i;
+    uint8_t read = 0;
+
+    if (cs->nclients == 0)
+        return -1;
+
+    now = now_ms();
+
+    for (i = 0; i < cs->nclients; i++) {
+        struct console_client *client = &cs->clients[i];
+
+        if (client->due <= now) {
+            if (!read) {
+                console_socket_words(cs, words);
+                read = 1;
+            }
+
+            if (console_socket_update(cs, client, words, now) != 0) {
+                console_socket_unsubscribe(cs, client);
+                i--;
+                continue;
+            }
+
+            client->due = now + client->interval;
+        }
+
+        if (client->due < next)
+            next = client->due;
+    }
+
+    if (cs->nclients == 0)
+        return -1;
+
+    return next - now;
+}
+
+static void *console_socket_thread(void *ctx)
+{
+    struct console_socket *cs = ctx;
+    struct epoll_event ev = { .events = EPOLLIN };
+    struct epoll_event events[2];
+    int ep, n, i, timeout = -1;
+
+    ge_log_set_active_types(cs->log_types);
+
+    ep = epoll_create1(0);
+    if (ep < 0) {
+        ge_log(LOG_ERR, "%s: epoll_create1: %s\n", cs->path, strerror(errno));
+        return NULL;
+    }
+
+    ev.data.fd = cs->fd;
+    epoll_ctl(ep, EPOLL_CTL_ADD, cs->fd, &ev);
+    ev.data.fd = cs->stop_fd;
+    epoll_ctl(ep, EPOLL_CTL_ADD, cs->stop_fd, &ev);
+
+    for (;;) {
+        n = epoll_wait(ep, events, 2, timeout);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0)
+            break;
+
+        for (i = 0; i < n; i++) {
+            if (events[i].data.fd == cs->stop_fd)
+                goto out;
+
+            console_socket_serve(cs);
+        }
+
+        timeout = console_socket_push(cs);
+    }
+
+out:
+    close(ep);
+    return NULL;
+}
+
+/* Whether another machine serves the socket at `sock` */
+static uint8_t console_socket_in_use(const struct sockaddr_un *sock)
+{
+    int sd = socket(AF_UNIX, SOCK_DGRAM, 0);
+    uint8_t r;
+
+    if (sd < 0)
+        return 0;
+
+    /* refused if nobody is bound to it any more */
+    r = connect(sd, (const struct sockaddr *)sock, sizeof(*sock)) == 0;
+    close(sd);
+    return r;
+}
 
 static int console_socket_init(struct ge *ge, void *ctx)
 {
+    struct console_socket *cs = ctx;
     int sd;
     struct sockaddr_un sock;
-    (void)ge;
-    (void)ctx;
-    unlink(socket_path);
+    struct stat st;
+
     memset(&sock, 0, sizeof(sock));
     sock.sun_family = AF_UNIX;
-    strcpy(sock.sun_path, socket_path);
+    strcpy(sock.sun_path, cs->path);
+
+    if (console_socket_in_use(&sock)) {
+        ge_log(LOG_ERR, "%s: served by another machine\n", cs->path);
+        return -1;
+    }
+
+    /* left by a machine that did not stop cleanly */
+    unlink(cs->path);
+
     sd = socket(AF_UNIX, SOCK_DGRAM, 0);
     if (sd < 0)
         return sd;
     fcntl(sd, F_SETFL, O_NONBLOCK);
-    if (bind(sd, (struct sockaddr *)&sock, sizeof(sock)) != 0) {
+    if (bind(sd, (struct sockaddr *)&sock, sizeof(sock)) != 0 ||
+        stat(cs->path, &st) != 0) {
         close(sd);
         return -1;
     }
 
-    console_socket_fd = sd;
+    cs->fd = sd;
+    cs->dev = st.st_dev;
+    cs->ino = st.st_ino;
+
+    cs->stop_fd = eventfd(0, 0);
+    if (cs->stop_fd < 0)
+        return -1;
+
+    /* something to send before the first cycle */
+    console_socket_publish(cs, ge);
+
+    if (pthread_create(&cs->thread, NULL, console_socket_thread, cs) != 0)
+        return -1;
+
+    cs->running = 1;
     return 0;
 }
 
+static int console_socket_deinit(struct ge *ge, void *ctx)
+{
+    struct console_socket *cs = ctx;
+    uint64_t one = 1;
+    (void)ge;
+
+    if (cs->running) {
+        if (write(cs->stop_fd, &one, sizeof(one)) == sizeof(one))
+            pthread_join(cs->thread, NULL);
+    }
+
+    if (cs->stop_fd >= 0)
+        close(cs->stop_fd);
 
-static int console_socket_check(struct ge *ge, void *ctx)
+    if (cs->fd >= 0) {
+        struct stat st;
+
+        if (stat(cs->path, &st) == 0 && st.st_dev == cs->dev && st.st_ino == cs->ino)
+            unlink(cs->path);
+        close(cs->fd);
+    }
+
+    free(cs->clients);
+    free(cs);
+    return 0;
+}
+
+static void console_socket_apply(struct ge *ge, struct console_command *cmd)
 {
-    char buf[1024];
-    struct sockaddr_un dst;
-    ssize_t ret;
-    socklen_t socket_size = sizeof(struct sockaddr_un);
-    struct ge_console console;
+    switch (cmd->type) {
+        case CONSOLE_MSG_SWITCHES:
+            ge_set_console_switches(ge, &cmd->switches);
+            break;
 
-    (void)ctx;
+        case CONSOLE_MSG_ROTARY:
+            ge_set_console_rotary(ge, cmd->rotary);
+            break;
 
-    if (console_socket_fd < 0) {
-        return -1;
+        case CONSOLE_MSG_BUTTONS:
+            if (cmd->buttons.CLEAR)
+                ge_clear(ge);
+
+            if (cmd->buttons.LOAD)
+                ge_load(ge);
+
+            if (cmd->buttons.HALT_START)
+                ge_start(ge);
+            break;
+
+        default:
+            break;
     }
+}
 
-    ge_fill_console_data(ge, &console);
+/* At the beginning of every cycle, apply the queued commands and
+ * publish the state for the consoles */
+static int console_socket_on_clock(struct ge *ge, void *ctx)
+{
+    struct console_socket *cs = ctx;
+    unsigned head = atomic_load_explicit(&cs->head, memory_order_acquire);
+    unsigned tail = atomic_load_explicit(&cs->tail, memory_order_relaxed);
 
-    ret = recvfrom(console_socket_fd, buf, 1024, 0,
-                   (struct sockaddr *)&dst, &socket_size);
-    if (ret > 0) {
-        ge_log(LOG_DEBUG, "doing check\n");
-        sendto(console_socket_fd, (unsigned char *)(&console),
-               sizeof(struct ge_console), 0, (struct sockaddr *)&dst,
-               socket_size);
+    for (; tail != head; tail++) {
+        console_socket_apply(ge, &cs->queue[tail % CONSOLE_SOCKET_QUEUE]);
+        atomic_store_explicit(&cs->tail, tail + 1, memory_order_release);
+        knots_changed(ge);
     }
 
+    /* nobody to publish to */
+    if (atomic_load_explicit(&cs->subscribed, memory_order_relaxed))
+        console_socket_publish(cs, ge);
+
     return 0;
 }
 
-static struct ge_peri console_socket = {
-    .init = console_socket_init,
-    .on_pulse = console_socket_check,
-};
-
-int console_socket_register(struct ge *ge)
+int console_socket_register(struct ge *ge, const char *path)
 {
-    return ge_register_peri(ge, &console_socket);
+    struct console_socket *cs;
+
+    if (path == NULL)
+        path = CONSOLE_SOCKET_PATH;
+
+    cs = calloc(1, sizeof(*cs));
+    if (cs == NULL)
+        return -1;
+
+    if (strlen(path) >= sizeof(cs->path)) {
+        free(cs);
+        return -1;
+    }
+
+    strcpy(cs->path, path);
+
+    cs->log_types = ge_log_active_types();
+    cs->fd = -1;
+    cs->stop_fd = -1;
+    cs->peri.init = console_socket_init;
+    cs->peri.on_clock = console_socket_on_clock;
+    cs->peri.deinit = console_socket_deinit;
+    cs->peri.ctx = cs;
+
+    return ge_register_peri(ge, &cs->peri);
 }
@@ -1,8 +1,90 @@
+/**
+ * @file  console_socket.h
+ * @brief Console protocol over a Unix datagram socket
+ *
+ * The consoles talk to the emulator with datagrams on the socket of the
+ * machine, CONSOLE_SOCKET_PATH unless another path is given to run
+ * several machines. Every message starts with a struct console_msg,
+ * followed by the payload of its type (see ENUMERATE_CONSOLE_MSGS). All
+ * the fields are in the byte order of the host.
+ *
+ * A console subscribes once, and the emulator pushes it the console
+ * state when it changes, at most once every `interval` milliseconds of
+ * the subscription. The state is made of CONSOLE_STATE_WORDS 16-bit
+ * words: the lamps (struct ge_console_lamps), the switches (struct
+ * ge_console_switches) and the rotary switch. An update carries a mask
+ * of the words that changed, followed by those words in order. The
+ * first update after subscribing carries all the words.
+ *
+ * The updates sent to a console are numbered by `seq`, one after the
+ * other: a console that finds a gap (an update could not be delivered)
+ * subscribes again to get all the words. The changes a slow console
+ * cannot receive are sent with its next update, and a console that
+ * cannot receive for a few seconds is unsubscribed.
+ *
+ * Switches, rotary switch and buttons are commands from the consoles,
+ * applied at the beginning of the next cycle.
+ */
+
 #ifndef CONSOLE_SOCKET_H
 #define CONSOLE_SOCKET_H
 
+#include <stdint.h>
+#include "console.h"
 #include "ge.h"
 
-int console_socket_register(struct ge *ge);
+#define CONSOLE_SOCKET_PATH "/tmp/gemu.console"
+
+#define CONSOLE_PROTOCOL_VERSION 1
+
+/* Updates interval of a subscription, in milliseconds */
+#define CONSOLE_INTERVAL_DEFAULT 20
+#define CONSOLE_INTERVAL_MIN     10
+
+/* The console state: lamps, switches and rotary switch */
+#define CONSOLE_STATE_LAMPS    0
+#define CONSOLE_STATE_SWITCHES 6
+#define CONSOLE_STATE_ROTARY   8
+#define CONSOLE_STATE_WORDS    9
+
+#define ENUMERATE_CONSOLE_MSGS                                           \
+    /* uint16_t interval in ms, 0 for the default */                    \
+    X(SUBSCRIBE,   1)                                                    \
+    X(UNSUBSCRIBE, 2)                                                    \
+    /* struct ge_console_switches */                                     \
+    X(SWITCHES,    3)                                                    \
+    /* uint16_t enum ge_console_rotary */                                \
+    X(ROTARY,      4)                                                    \
+    /* struct ge_console_buttons, the buttons pressed */                 \
+    X(BUTTONS,     5)                                                    \
+    /* from the emulator: uint16_t mask of the words, then the words */ \
+    X(UPDATE,      6)
+
+enum console_msg_type {
+#define X(name, type) CONSOLE_MSG_##name = type,
+    ENUMERATE_CONSOLE_MSGS
+#undef X
+};
+
+/// Header of the console messages
+struct PACKED console_msg {
+    uint8_t version; ///< CONSOLE_PROTOCOL_VERSION
+    uint8_t type;    ///< enum console_msg_type
+    uint16_t seq;    ///< Number of the update, 0 from the consoles
+};
+
+/**
+ * Serve the consoles of `ge`
+ *
+ * The thread serving the socket logs the types active in the calling
+ * thread.
+ *
+ * @param path the socket, NULL for CONSOLE_SOCKET_PATH. Replaced if it
+ *             is left by a machine that did not stop, and removed by
+ *             ge_deinit()
+ * @return 0 on success, -1 if the socket cannot be created or another
+ *         machine serves it
+ */
+int console_socket_register(struct ge *ge, const char *path);
 
-#endif
+#endif /* CONSOLE_SOCKET_H */
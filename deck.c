@@ -0,0 +1,169 @@
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "deck.h"
+#include "log.h"
+#include "reader.h"
+
+size_t ge_deck_card_length(uint8_t command)
+{
+    switch (command) {
+        case READER_read:
+        case READER_read_normal_1:
+        case READER_read_normal_2:
+        case READER_read_mixed_1:
+        case READER_read_mixed_2:
+            return GE_DECK_COLUMNS;
+        case READER_read_binary:
+            return 2 * GE_DECK_COLUMNS;
+        default:
+            return 0;
+    }
+}
+
+/* A character every other cycle: strobed with LU08 while the machine
+ * waits for it in state b8, taken in the next cycle, as done by
+ * tests/initial-load.c */
+static int deck_on_clock(struct ge *ge, void *ctx)
+{
+    struct ge_deck *deck = ctx;
+    size_t length;
+
+    if (ge->integrated_reader.lu08) {
+        reader_clear_sending(ge);
+        return 0;
+    }
+
+    if (ge->rSO != 0xb8 || deck->pos >= deck->size)
+        return 0;
+
+    /* a new card, as long as the command the reader was given says, once
+     * the end of the previous one has been reset by the machine (CE03) */
+    if (deck->pos == deck->card_end) {
+        if (ge->RIG1)
+            return 0;
+
+        length = ge_deck_card_length(ge->rRE);
+        if (length == 0)
+            return 0;
+
+        deck->card_end = deck->pos + length;
+        if (deck->card_end > deck->size)
+            deck->card_end = deck->size;
+
+        deck->cards++;
+        ge_log(LOG_READER, "deck: card %llu, %zu characters\n",
+               (unsigned long long)deck->cards, deck->card_end - deck->pos);
+    }
+
+    reader_setup_to_send(ge, deck->data[deck->pos], deck->pos + 1 == deck->card_end);
+    deck->pos++;
+
+    return 0;
+}
+
+/* The position in the deck, so the machines resumed from a snapshot go
+ * on reading the deck where it was left */
+static int deck_save(struct ge *ge, void *ctx, struct ge_snapshot_buf *buf)
+{
+    struct ge_deck *deck = ctx;
+    uint64_t pos[3] = { deck->pos, deck->card_end, deck->cards };
+
+    return ge_snapshot_put(buf, pos, sizeof(pos));
+}
+
+static int deck_load(struct ge *ge, void *ctx, const uint8_t *data, size_t size)
+{
+    struct ge_deck *deck = ctx;
+    uint64_t pos[3] = { 0 };
+
+    /* only the position in older snapshots */
+    if (size < sizeof(pos[0]))
+        return -1;
+
+    if (size > sizeof(pos))
+        size = sizeof(pos);
+
+    memcpy(pos, data, size);
+    if (size < 2 * sizeof(pos[0]))
+        pos[1] = pos[0];
+
+    if (pos[1] < pos[0] || pos[1] > deck->size)
+        pos[1] = pos[0] = pos[0] < deck->size ? pos[0] : deck->size;
+
+    deck->pos = pos[0];
+    deck->card_end = pos[1];
+    deck->cards = pos[2];
+    return 0;
+}
+
+void ge_deck_init(struct ge_deck *deck, const uint8_t *data, size_t size)
+{
+    memset(deck, 0, sizeof(*deck));
+    deck->data = data;
+    deck->size = size;
+}
+
+int ge_deck_open(struct ge_deck *deck, const char *path)
+{
+    struct stat st;
+    void *data;
+    int fd;
+
+    ge_deck_init(deck, NULL, 0);
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return -1;
+
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    /* nothing to map */
+    if (st.st_size == 0) {
+        close(fd);
+        return 0;
+    }
+
+    data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (data == MAP_FAILED)
+        return -1;
+
+    madvise(data, st.st_size, MADV_SEQUENTIAL);
+
+    deck->data = data;
+    deck->size = st.st_size;
+    deck->mapped = st.st_size;
+    return 0;
+}
+
+void ge_deck_close(struct ge_deck *deck)
+{
+    if (deck->mapped)
+        munmap((void *)deck->data, deck->mapped);
+
+    ge_deck_init(deck, NULL, 0);
+}
+
+int ge_deck_register(struct ge *ge, struct ge_deck *deck)
+{
+    deck->peri.on_clock = deck_on_clock;
+    deck->peri.ctx = deck;
+
+    deck->section.name = "deck";
+    deck->section.save = deck_save;
+    deck->section.load = deck_load;
+    deck->section.ctx = deck;
+
+    if (ge_snapshot_register_section(ge, &deck->section) != 0)
+        return -1;
+
+    return ge_register_peri(ge, &deck->peri);
+}
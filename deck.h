@@ -0,0 +1,78 @@
+/**
+ * @file  deck.h
+ * @brief Card deck for the integrated reader
+ *
+ * A peripheral feeding a card deck, read from a file, to the integrated
+ * reader: while the machine waits for a character (state b8) the next
+ * character of the card is strobed with LU08, and the last one of every
+ * card with FINI as well.
+ *
+ * The deck file holds the characters sent by the reader, card after
+ * card, with no header nor separators. How long a card is depends on
+ * the command the reader has been given (see ENUMERATE_READER_COMMANDS)
+ * when the card is fed:
+ *
+ * - read unchanged, normal and mixed: one character per column,
+ *   GE_DECK_COLUMNS characters;
+ * - read binary: the 12 rows of every column as two characters of 6
+ *   rows each (12 to 3, then 4 to 9), 2 * GE_DECK_COLUMNS characters.
+ *
+ * The same file can be read in both modes, the program decides. The last
+ * card may be shorter, it ends with the file. Other commands feed
+ * nothing.
+ *
+ * The file is mapped in memory, not copied, and the position in the deck
+ * is saved in the snapshots (section "deck").
+ */
+
+#ifndef DECK_H
+#define DECK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "ge.h"
+#include "snapshot.h"
+
+/// Columns of a card
+#define GE_DECK_COLUMNS 80
+
+/// Card deck
+struct ge_deck {
+    struct ge_peri peri;
+    struct ge_snapshot_section section;
+
+    const uint8_t *data; ///< The characters of the deck
+    size_t size;         ///< Size of the deck
+    size_t mapped;       ///< Size of the mapping of the file, 0 if not mapped
+
+    size_t pos;          ///< Next character
+    size_t card_end;     ///< End of the card being read, `pos` between cards
+    uint64_t cards;      ///< Cards fed
+};
+
+/**
+ * Open a deck file
+ *
+ * @return 0 on success, -1 if the file cannot be opened or mapped
+ */
+int ge_deck_open(struct ge_deck *deck, const char *path);
+
+/// Use a deck already in memory, which must last as long as `deck`
+void ge_deck_init(struct ge_deck *deck, const uint8_t *data, size_t size);
+
+/// Release the deck, unmapping the file
+void ge_deck_close(struct ge_deck *deck);
+
+/**
+ * Attach the deck to the integrated reader of `ge`
+ *
+ * Registers the peripheral and its snapshot section.
+ *
+ * @return 0 on success, -1 on errors
+ */
+int ge_deck_register(struct ge *ge, struct ge_deck *deck);
+
+/// Characters of a card read with `command`, 0 if it reads nothing
+size_t ge_deck_card_length(uint8_t command);
+
+#endif /* DECK_H */
@@ -5,15 +5,21 @@
 #include "ge.h"
 #include "signals.h"
 #include "msl.h"
+#include "msl-timings.h"
 #include "console_socket.h"
 #include "peripherical.h"
 #include "log.h"
+#include "trace.h"
+#include "mem.h"
+#include "profile.h"
 
 #define MAX_PROGRAM_STORAGE_WORDS 129
 
 void ge_init(struct ge *ge)
 {
     memset(ge, 0, sizeof(*ge));
+    msl_init();
+
     ge->halted = 1;
     ge->powered = 1;
     ge->register_selector = RS_NORM;
@@ -55,8 +61,7 @@ int ge_load_program(struct ge *ge, uint8_t *program, uint8_t size)
         size = MAX_PROGRAM_STORAGE_WORDS;
 
     /* simulate the loading for now */
-    memcpy(ge->mem, program, size);
-    return 0;
+    return ge_mem_load(ge, 0, program, size);
 }
 
 void ge_load(struct ge *ge)
@@ -128,33 +133,69 @@ const char *ge_clock_name(enum clock c)
     return "";
 }
 
+static void ge_trace_registers(struct ge *ge, enum ge_trace_kind kind,
+                               struct ge_trace_record *r)
+{
+    memset(r, 0, sizeof(*r));
+
+    r->kind  = kind;
+    r->clock = ge->current_clock;
+    r->rSO   = ge->rSO;
+    r->rSA   = ge->rSA;
+    r->rPO   = ge->rPO;
+    r->rRO   = ge->rRO;
+    r->rBO   = ge->rBO;
+    r->rFO   = ge->rFO;
+    r->ffFA  = ge->ffFA;
+    r->ffFI  = ge->ffFI;
+    r->rV1   = ge->rV1;
+    r->rV2   = ge->rV2;
+    r->rV3   = ge->rV3;
+    r->rV4   = ge->rV4;
+    r->rL1   = ge->rL1;
+    r->rL2   = ge->rL2;
+    r->rL3   = ge->rL3;
+
+    if (kind == TRACE_PULSE) {
+        r->NO = NO_knot(ge);
+        r->NI = NI_knot(ge);
+    }
+}
+
+static void ge_dump_registers(struct ge *ge, enum ge_trace_kind kind,
+                              ge_log_type type)
+{
+    struct ge_trace_record r;
+    char line[0x100];
+
+    if (ge->trace) {
+        ge_trace_registers(ge, kind, &r);
+        ge_trace_append(ge->trace, &r);
+        return;
+    }
+
+    if (!ge_log_enabled(type))
+        return;
+
+    ge_trace_registers(ge, kind, &r);
+    ge_trace_format(&r, line, sizeof(line));
+    ge_log(type, "%s", line);
+}
+
 void ge_print_registers_nonverbose(struct ge *ge)
 {
-    if (ge_log_enabled(LOG_REGS_V)) return;
-    ge_log(LOG_REGS,
-           "SO: %02x SA: %02x PO: %04x RO: %04x BO: %04x FO: %04x -  "
-           "V1: %04x  V2: %04x V3: %04x  V4: %04x - "
-           "L1: %04x  L2: %04x L3 : %04x\n",
-           ge->rSO, ge->rSA, ge->rPO, ge->rRO, ge->rBO, ge->rFO,
-           ge->rV1, ge->rV2, ge->rV3, ge->rV4,
-           ge->rL1, ge->rL2, ge->rL3);
+    if (!ge->trace && ge_log_enabled(LOG_REGS_V)) return;
+    ge_dump_registers(ge, TRACE_CYCLE, LOG_REGS);
 }
 
 void ge_print_registers_verbose(struct ge *ge)
 {
-    ge_log(LOG_REGS_V,
-           "%s:  "
-           "SO: %02x SA: %02x PO: %04x RO: %04x BO: %04x FO: %04x  -  "
-           "NO: %02x NI: %02x  -  "
-           "FA: %02x FI: %02x - "
-           "V1: %04x  V2: %04x V3: %04x  V4: %04x - "
-           "L1: %04x  L2: %04x L3 : %04x\n",
-           ge_clock_name(ge->current_clock),
-           ge->rSO, ge->rSA, ge->rPO, ge->rRO, ge->rBO, ge->rFO,
-           NO_knot(ge), NI_knot(ge),
-           ge->ffFA, ge->ffFI,
-           ge->rV1, ge->rV2, ge->rV3, ge->rV4,
-           ge->rL1, ge->rL2, ge->rL3);
+    ge_dump_registers(ge, TRACE_PULSE, LOG_REGS_V);
+}
+
+void ge_set_trace(struct ge *ge, struct ge_trace *trace)
+{
+    ge->trace = trace;
 }
 
 void ge_clock_increment(struct ge* ge)
@@ -174,12 +215,14 @@ uint8_t ge_clock_is_last(struct ge* ge)
     return ge->current_clock == (END_OF_STATUS - 1);
 }
 
-int ge_run_pulse(struct ge *ge)
+static int run_pulse(struct ge *ge)
 {
     int r;
     struct msl_timing_state *state;
 
     if (ge_clock_is_first(ge)) {
+        ge_peri_schedule(ge);
+
         r = ge_peri_on_clock(ge);
         if (r != 0)
             return r;
@@ -204,12 +247,10 @@ int ge_run_pulse(struct ge *ge)
     if (ge->current_clock == TO10)
         ge_print_well_known_states(ge->rSA);
 
-    if (!state) {
-        ge_log(LOG_ERR, "no timing charts found for state %02X\n", ge->rSA);
-        return 1;
-    }
-
-    msl_run_state(ge, state);
+    /* the states without a timing chart trap here */
+    r = msl_run_state(ge, state);
+    if (r != 0)
+        return r;
 
     if (ge_clock_is_last(ge)) {
         fsn_last_clock(ge);
@@ -220,10 +261,58 @@ int ge_run_pulse(struct ge *ge)
     return 0;
 }
 
+int ge_run_pulse(struct ge *ge)
+{
+    uint64_t start = 0;
+    int r;
+
+    if (!ge->profile && !ge->guest_profile)
+        return run_pulse(ge);
+
+    if (ge->guest_profile && ge_clock_is_first(ge))
+        ge_guest_profile_cycle(ge, 0);
+
+    if (ge->profile)
+        start = ge_profile_ticks();
+
+    r = run_pulse(ge);
+
+    if (ge->profile)
+        ge_profile_pulse(ge, ge_profile_ticks() - start);
+
+    /* the last clock of the cycle has been run */
+    if (ge->guest_profile && r == 0 && ge_clock_is_first(ge))
+        ge_guest_profile_cycle(ge, 1);
+
+    return r;
+}
+
 int ge_run_cycle(struct ge *ge)
 {
+    struct msl_timing_state *state;
+    uint32_t active;
+
+    /* the first and last clocks always do something */
+    active = pulse_active_clocks()
+           | GE_CLOCK_BIT(TO00)
+           | GE_CLOCK_BIT(END_OF_STATUS - 1);
+
     do {
-        int r = ge_run_pulse(ge);
+        int r;
+
+        /* SA can change during the cycle, so the state is looked up
+         * at every pulse. Unknown states are active at every clock, to
+         * report them. The awake peripherals are known after the first
+         * pulse. */
+        state = msl_get_state(ge->rSA);
+
+        if (!((active | ge->peri_clocks | state->active_clocks) &
+              GE_CLOCK_BIT(ge->current_clock))) {
+            ge_clock_increment(ge);
+            continue;
+        }
+
+        r = ge_run_pulse(ge);
         if (r)
             return r;
     } while (!ge_clock_is_first(ge));
@@ -234,6 +323,7 @@ int ge_run_cycle(struct ge *ge)
 int ge_deinit(struct ge *ge)
 {
     ge_peri_deinit(ge);
+    ge_mem_release(ge);
     return 0;
 }
 
@@ -7,6 +7,7 @@
 #include "reader.h"
 
 #define CLOCK_PERIOD 14000 /* in usec, interval between pulse lines */
+#define CYCLE_PERIOD_NS 8000 /* in nsec, duration of a delay line cycle of the real machine */
 #define MEM_SIZE 65536
 
 #define ENUMERATE_CLOCKS \
@@ -87,6 +88,20 @@ struct ge_knot_ni {
     enum knot_ni_source ni4;
 };
 
+/**
+ * Materialized knots
+ *
+ * The last values of the NO and NI knots, valid until one of the
+ * registers or selectors driving them changes (see NO_changed() and
+ * NI_changed() in signals.h).
+ */
+struct ge_knot_cache {
+    uint16_t no;
+    uint16_t ni;
+    uint8_t no_valid:1;
+    uint8_t ni_valid:1;
+};
+
 /**
  * The entire state of the emulated system, including registers, memory,
  * peripherals and timings.
@@ -139,6 +154,8 @@ struct ge {
      */
     struct ge_knot_ni kNI;
 
+    struct ge_knot_cache knots;
+
     /**
      * Multipurpose 8+1 bit register
      *
@@ -527,6 +544,14 @@ struct ge {
 
     uint8_t mem[MEM_SIZE]; ///< The memory of the emulated system
 
+    /**
+     * Paged memory
+     *
+     * If set, the memory is in these copy on write pages instead of
+     * `mem` (see mem.h).
+     */
+    struct ge_mem_pages *pages;
+
     struct ge_counting_network counting_network;
 
     /**
@@ -546,6 +571,42 @@ struct ge {
 
     struct ge_peri *peri;
 
+    /// Clocks at which some peripheral is awake, see ge_peri_schedule()
+    uint32_t peri_clocks;
+
+    /**
+     * Binary register trace
+     *
+     * If set, the register dumps are appended here instead of being
+     * logged with LOG_REGS_V and LOG_REGS.
+     */
+    struct ge_trace *trace;
+
+    /// Peripheral sections saved and loaded with the snapshots
+    struct ge_snapshot_section *snapshot_sections;
+
+    /// Interpret the timing charts instead of running the compiled ones
+    uint8_t msl_interpreted;
+
+    /**
+     * Execution profile
+     *
+     * If set, the pulses, the cycles and the rows of the timing charts
+     * run are counted here, see profile.h.
+     */
+    struct ge_profile *profile;
+
+    /// Counters of the rows of the state being run, in `profile`
+    struct ge_profile_row *profile_rows;
+
+    /**
+     * Guest profile
+     *
+     * If set, the instructions fetched and the cycles they take are
+     * counted here, by address, see profile.h.
+     */
+    struct ge_guest_profile *guest_profile;
+
     /**
      * Workaround for pulse TO50
      *
@@ -575,7 +636,13 @@ int ge_run(struct ge *ge);
 /// Run a single pulse (i.e. a single GE "mastri" clock periods)
 int ge_run_pulse(struct ge *ge);
 
-/// Run all GE "mastri" clock periods until next clock cycle
+/**
+ * Run all GE "mastri" clock periods until next clock cycle
+ *
+ * The pulses where nothing would happen (no common logic, no awake
+ * peripherals and no timing chart rows for the current state) are
+ * skipped.
+ */
 int ge_run_cycle(struct ge *ge);
 
 /// Emulate the press of the "clear" button in the console
@@ -603,6 +670,12 @@ struct pulse_event {
 /* Defined in pulse.c: execute pulse events */
 void pulse(struct ge *ge);
 
+/* Defined in pulse.c: mask of the clocks with common pulse logic */
+uint32_t pulse_active_clocks(void);
+
+#define GE_CLOCK_BIT(c) (1u << (c))
+#define GE_ALL_CLOCKS   (GE_CLOCK_BIT(END_OF_STATUS) - 1)
+
 struct ge_peri {
     struct ge_peri *next;
     int (*init)(struct ge*, void*);
@@ -610,10 +683,41 @@ struct ge_peri {
     int (*on_clock)(struct ge*, void*);
     int (*deinit)(struct ge*, void*);
     void *ctx;
+
+    /*
+     * Scheduling of on_pulse, initialized by ge_register_peri() to
+     * every pulse of every cycle, changed with the ge_peri_wake_*
+     * functions.
+     */
+    uint32_t clocks;    ///< Mask of the clocks on_pulse is called at
+    uint32_t period;    ///< If not 0, wake up once every `period` cycles
+    uint32_t countdown; ///< Cycles left before the next wake up
+    int fd;             ///< If not -1, wake up only if readable
+    uint8_t awake;      ///< on_pulse is called in the current cycle
 };
 
+/**
+ * Register a peripheral
+ *
+ * The `init` callback is called after the scheduling fields have been
+ * initialized, so it can call the ge_peri_wake_* functions.
+ */
 int ge_register_peri(struct ge *ge, struct ge_peri *p);
 
+/// Call on_pulse only at the clocks in `clocks` (a mask of GE_CLOCK_BIT)
+void ge_peri_wake_on_clocks(struct ge_peri *p, uint32_t clocks);
+
+/// Call on_pulse only once every `cycles` cycles, 0 for every cycle
+void ge_peri_wake_every(struct ge_peri *p, uint32_t cycles);
+
+/**
+ * Call on_pulse only when `fd` is readable
+ *
+ * The descriptor is polled once at the beginning of the cycles the
+ * peripheral would be woken up at. -1 to stop polling.
+ */
+void ge_peri_wake_on_fd(struct ge_peri *p, int fd);
+
 /**
  * Commit the future state
  *
@@ -632,6 +736,15 @@ void connectors_first_clock(struct ge *ge);
  */
 const char *ge_clock_name(enum clock c);
 
+/**
+ * Dump the registers
+ *
+ * Appends them to the binary trace if one is set, otherwise logs them
+ * with LOG_REGS_V.
+ */
 void ge_print_registers_verbose(struct ge *ge);
 
+/// Set (or reset, if NULL) the binary register trace
+void ge_set_trace(struct ge *ge, struct ge_trace *trace);
+
 #endif /* GE_H */
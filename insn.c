@@ -0,0 +1,225 @@
+#include <stdint.h>
+
+#include "insn.h"
+#include "mem.h"
+#include "opcodes.h"
+#include "signals.h"
+#include "peripherical.h"
+#include "profile.h"
+
+/* Cycles of the states run by the supported instructions:
+ * E2, E0, 64 for the P format, E2, E0, E4, E6, 65 for the PM format */
+#define P_FORMAT_CYCLES  3
+#define PM_FORMAT_CYCLES 5
+
+/* The alpha phase starts in E2 (E3 is only reached by the interrupts) */
+#define ALPHA_STATE 0xe2
+
+/* Only the peripherals called once per cycle, not on the pulses */
+static uint8_t insn_peri_allowed(struct ge *ge)
+{
+    struct ge_peri *p;
+
+    for (p = ge->peri; p != NULL; p = p->next) {
+        if (p->on_pulse)
+            return 0;
+    }
+
+    return 1;
+}
+
+/* Can the next instruction be run without looking at the single cycles? */
+static uint8_t insn_can_run(struct ge *ge)
+{
+    struct ge_console_switches *s = &ge->console_switches;
+
+    if (ge->current_clock != TO00 || ge->rSO != ALPHA_STATE)
+        return 0;
+
+    if (ge->halted || ge->ALTO || ge->step_by_step)
+        return 0;
+
+    if (s->PAPA || s->PATE || s->RICI || s->ACOV || s->ACON)
+        return 0;
+
+    if (ge->register_selector != RS_NORM)
+        return 0;
+
+    /* only cpu cycles, no interrupts */
+    if (!ge->RC00 || ge->RC01 || ge->RC02 || ge->RC03 || ge->RINT)
+        return 0;
+
+    if (ge->counting_network.cmds.decresing || ge->memory_command != MC_NONE)
+        return 0;
+
+    /* the trace and the profile want to see every pulse */
+    if (ge->trace || ge->profile || RA101(ge))
+        return 0;
+
+    return 1;
+}
+
+/* The P format instructions with no operands */
+static uint8_t insn_p_supported(uint8_t op, uint8_t c2)
+{
+    if (op == NOP2_OPCODE)
+        return 1;
+
+    return op == LON_OPCODE &&
+           (c2 == LON_2NDCHAR || c2 == LOFF_2NDCHAR ||
+            c2 == INS_2NDCHAR || c2 == ENS_2NDCHAR);
+}
+
+/* The jumps, with a direct address (no indexing nor indirection) */
+static uint8_t insn_pm_supported(uint8_t op, uint8_t c2, uint8_t hi)
+{
+    if (hi & 0xf0)
+        return 0;
+
+    return op == JC_OPCODE ||
+           (op == JS1_OPCODE &&
+            (c2 == JS1_2NDCHAR || c2 == JS2_2NDCHAR || c2 == JIE_2NDCHAR));
+}
+
+/* Side effects of the beta phase of the P instructions (state 64) */
+static void insn_p_beta(struct ge *ge, uint8_t op, uint8_t c2)
+{
+    if (op != LON_OPCODE)
+        return;
+
+    switch (c2) {
+        case LON_2NDCHAR:  ge->ALAM = 1; ge->PODI = 1; break; /* CI87 */
+        case LOFF_2NDCHAR: ge->ALAM = 0; ge->PODI = 0; break; /* CI88 */
+        case INS_2NDCHAR:  ge->ADIR = 1;               break; /* CI77 */
+        case ENS_2NDCHAR:  ge->ADIR = 0;               break; /* CI78 */
+    }
+}
+
+/* The registers left by the timing charts at the end of every cycle of
+ * an instruction, as they are at the beginning of the next one */
+static void insn_end(struct ge *ge, uint8_t beta_state)
+{
+    /* E2: CI80, CI83 */
+    RESET_BIT(ge->ffFI, 0);
+    RESET_BIT(ge->ffFI, 3);
+    ge->ffFA = ge->ffFI;
+
+    /* E0: CI39 */
+    ge->AVER = 0;
+    ge->AINI = 0;
+    ge->PIC1 = 0;
+    ge->RASI = 0;
+
+    /* beta: CO49 */
+    ge->URPE = 0;
+    ge->URPU = 0;
+
+    /* common logic of the last cycle */
+    ge->RIA0 = 1;
+    ge->RESI = 0;
+    ge->RIA2 = 0;
+    ge->RIA3 = 0;
+    ge->RETO = RES01(ge);
+    ge->RECE = 0;
+    ge->PEC1 = 0;
+    ge->ACIC = 1;
+    ge->rRO = 0;
+    ge->TO50_did_CI32_or_CI33 = 0;
+    ge->counting_network.cmds.from_zero = 0;
+
+    ge->kNO.forcings = 0;
+    ge->kNO.force_mode = KNOT_FORCING_NONE;
+    ge->kNO.cmd = KNOT_V2_IN_NO;
+    ge->kNI.ni1 = NS_CN1;
+    ge->kNI.ni2 = NS_CN2;
+    ge->kNI.ni3 = NS_CN3;
+    ge->kNI.ni4 = NS_CN4;
+    knots_changed(ge);
+
+    ge->rSA = beta_state;
+    ge->rSO = ALPHA_STATE;
+    ge->future_state = ALPHA_STATE;
+}
+
+/* The cycles of the instruction at PO, 0 if it is not supported */
+static unsigned insn_decode(struct ge *ge)
+{
+    uint16_t po = ge->rPO;
+    uint8_t op = ge_mem_read(ge, po);
+    uint8_t c2 = ge_mem_read(ge, po + 1);
+
+    if (insn_p_supported(op, c2))
+        return P_FORMAT_CYCLES;
+
+    if (insn_pm_supported(op, c2, ge_mem_read(ge, po + 2)))
+        return PM_FORMAT_CYCLES;
+
+    return 0;
+}
+
+unsigned ge_insn_run(struct ge *ge)
+{
+    uint16_t po = ge->rPO;
+    uint8_t op, c2, hi, lo;
+    unsigned cycles;
+
+    if (!insn_can_run(ge) || !insn_peri_allowed(ge) || !insn_decode(ge))
+        return 0;
+
+    /* the first clock of the instruction, the peripherals can change
+     * the console (e.g. the console socket) or the memory */
+    if (ge->peri) {
+        if (ge_peri_on_clock(ge) != 0 || !insn_can_run(ge))
+            return 0;
+    }
+
+    cycles = insn_decode(ge);
+    op = ge_mem_read(ge, po);
+    c2 = ge_mem_read(ge, po + 1);
+
+    if (cycles == P_FORMAT_CYCLES) {
+        ge->rFO = op;
+        ge->rL1 = c2;
+        ge->rPO = po + 2;
+        ge->rV2 = po + 1;
+        ge->rVO = po + 1;
+        ge->rBO = po + 1;
+
+        insn_p_beta(ge, op, c2);
+        insn_end(ge, 0x64);
+    } else if (cycles == PM_FORMAT_CYCLES) {
+        hi = ge_mem_read(ge, po + 2);
+        lo = ge_mem_read(ge, po + 3);
+
+        /* E6 does not enable CI38 (see state_E6_TO80_CI38): AVER stays
+         * reset and the jump is not taken, as in the timing charts */
+        ge->rFO = op;
+        ge->rL1 = c2;
+        ge->rL2 = hi;
+        ge->rPO = po + 4;
+        ge->rV1 = po + 4;
+        ge->rVO = po + 4;
+        ge->rV2 = (hi << 8 | lo) & 0x0fff;
+        ge->rBO = ge->rV2;
+
+        insn_end(ge, 0x65);
+    }
+
+    if (ge->guest_profile)
+        ge_guest_profile_insn(ge, po, cycles);
+
+    return cycles;
+}
+
+int ge_run_step(struct ge *ge, uint64_t *cycles)
+{
+    unsigned n = ge_insn_run(ge);
+
+    if (n) {
+        *cycles += n;
+        return 0;
+    }
+
+    *cycles += 1;
+    return ge_run_cycle(ge);
+}
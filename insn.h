@@ -0,0 +1,49 @@
+/**
+ * @file  insn.h
+ * @brief Instruction level execution
+ *
+ * A faster alternative to running the machine pulse by pulse. When the
+ * machine is about to fetch an instruction (state E2 at TO00), the
+ * simplest instructions are executed in one go on the registers, leaving
+ * the machine exactly as the timing charts would at the beginning of the
+ * next instruction.
+ *
+ * Everything else is left to the pulse engine: the instructions that are
+ * not supported here, the console switches that need the single cycles
+ * (PAPA, PATE, RICI, ACOV, ACON or the rotary switch out of the normal
+ * position), pending interrupts and channel cycles, the peripherals
+ * called on the pulses, the binary trace and the profiler.
+ *
+ * The peripherals with only an on_clock callback are called once at the
+ * beginning of every instruction. If they change the machine so that the
+ * instruction can not be run anymore, the cycle is left to the pulse
+ * engine and on_clock is called again for it.
+ */
+
+#ifndef INSN_H
+#define INSN_H
+
+#include <stdint.h>
+#include "ge.h"
+
+/**
+ * Runs a whole instruction
+ *
+ * @return the number of cycles the instruction takes on the real
+ *         machine, or 0 if the instruction can not be run at this level
+ *         and nothing was done
+ */
+unsigned ge_insn_run(struct ge *ge);
+
+/**
+ * Runs an instruction, or a cycle
+ *
+ * Runs the next instruction with ge_insn_run() if possible, otherwise a
+ * single cycle with ge_run_cycle(). The cycles elapsed on the emulated
+ * machine are added to `cycles`.
+ *
+ * @return 0 on success, the error of ge_run_cycle() otherwise
+ */
+int ge_run_step(struct ge *ge, uint64_t *cycles);
+
+#endif /* INSN_H */
@@ -0,0 +1,140 @@
+#include <string.h>
+
+#include "lockstep.h"
+#include "mem.h"
+#include "snapshot.h"
+
+#define FNV_OFFSET 2166136261u
+#define FNV_PRIME  16777619u
+
+static uint32_t digest_add(uint32_t h, uint16_t value)
+{
+    h = (h ^ (value & 0xff)) * FNV_PRIME;
+    h = (h ^ (value >> 8)) * FNV_PRIME;
+    return h;
+}
+
+static uint32_t cpu_digest(struct ge *ge)
+{
+    uint32_t h = FNV_OFFSET;
+
+#define X8(f)  h = digest_add(h, ge->f);
+#define X16(f) h = digest_add(h, ge->f);
+    ENUMERATE_CPU_FIELDS
+#undef X8
+#undef X16
+
+    return h;
+}
+
+static int diverged(struct ge *ref, struct ge_lockstep_report *report,
+                    const char *field, uint32_t reference, uint32_t candidate)
+{
+    report->field     = field;
+    report->reference = reference;
+    report->candidate = candidate;
+    report->rSO       = ref->rSO;
+    report->rSA       = ref->rSA;
+    report->rPO       = ref->rPO;
+    report->clock     = ref->current_clock;
+    return -1;
+}
+
+static int compare_cpu(struct ge *ref, struct ge *cand,
+                       struct ge_lockstep_report *report)
+{
+    if (cpu_digest(ref) == cpu_digest(cand))
+        return 0;
+
+#define X8(f)                                                       \
+    if (ref->f != cand->f)                                          \
+        return diverged(ref, report, #f, ref->f, cand->f);
+#define X16(f) X8(f)
+    ENUMERATE_CPU_FIELDS
+#undef X8
+#undef X16
+
+    return 0;
+}
+
+static int compare_mem(struct ge *ref, struct ge *cand,
+                       struct ge_lockstep_report *report)
+{
+    const uint8_t *r, *c;
+    int page, i;
+
+    for (page = 0; page < MEM_PAGES; page++) {
+        r = ge_mem_page_data(ref, page);
+        c = ge_mem_page_data(cand, page);
+
+        /* shared by forked machines */
+        if (r == c || memcmp(r, c, MEM_PAGE_SIZE) == 0)
+            continue;
+
+        for (i = 0; r[i] == c[i]; i++)
+            ;
+
+        report->addr = page * MEM_PAGE_SIZE + i;
+        return diverged(ref, report, "mem", r[i], c[i]);
+    }
+
+    return 0;
+}
+
+int ge_lockstep_cycle(struct ge *ge, uint64_t *cycles)
+{
+    *cycles += 1;
+    return ge_run_cycle(ge);
+}
+
+int ge_lockstep_compare(struct ge *ref, struct ge *cand,
+                        struct ge_lockstep_report *report)
+{
+    if (compare_cpu(ref, cand, report) != 0)
+        return -1;
+
+    return compare_mem(ref, cand, report);
+}
+
+int ge_lockstep_run(struct ge *ref, struct ge *cand, ge_lockstep_step step,
+                    uint64_t cycles, struct ge_lockstep_report *report)
+{
+    uint64_t ref_cycles = 0, cand_cycles = 0;
+    int r, c;
+
+    memset(report, 0, sizeof(*report));
+
+    while (cand_cycles < cycles && !ref->ALTO) {
+        c = step(cand, &cand_cycles);
+
+        for (r = 0; ref_cycles < cand_cycles && r == 0; ref_cycles++)
+            r = ge_run_cycle(ref);
+
+        report->cycles = ref_cycles;
+
+        if (r != c)
+            return diverged(ref, report, "return", r, c);
+
+        if (r != 0)
+            return 0;
+
+        if (ge_lockstep_compare(ref, cand, report) != 0)
+            return -1;
+    }
+
+    return 0;
+}
+
+void ge_lockstep_print(const struct ge_lockstep_report *report, FILE *f)
+{
+    fprintf(f, "diverged after %llu cycles, SO %02x SA %02x %s PO %04x: ",
+            (unsigned long long)report->cycles, report->rSO, report->rSA,
+            ge_clock_name(report->clock), report->rPO);
+
+    if (strcmp(report->field, "mem") == 0)
+        fprintf(f, "mem[%04x]", report->addr);
+    else
+        fprintf(f, "%s", report->field);
+
+    fprintf(f, " reference %x candidate %x\n", report->reference, report->candidate);
+}
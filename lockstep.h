@@ -0,0 +1,76 @@
+/**
+ * @file  lockstep.h
+ * @brief Lockstep differential checker
+ *
+ * Runs two machines side by side: a reference one, cycle by cycle with
+ * ge_run_cycle(), and a candidate one with the engine under test. Every
+ * time the candidate completes a step (a cycle, or a whole instruction
+ * with ge_run_step()) the reference is brought to the same cycle and the
+ * two machines are compared: the CPU fields saved by the snapshots (see
+ * ENUMERATE_CPU_FIELDS) and the memory.
+ *
+ * The comparison is done on a digest of the fields first, the fields are
+ * only looked at one by one to report the first difference.
+ */
+
+#ifndef LOCKSTEP_H
+#define LOCKSTEP_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "ge.h"
+
+/**
+ * Step of the candidate engine
+ *
+ * Runs the machine for one or more whole cycles, adding them to
+ * `cycles`. Returns 0 on success, like ge_run_cycle(). ge_run_step()
+ * and ge_lockstep_cycle() can be used as is.
+ */
+typedef int (*ge_lockstep_step)(struct ge *ge, uint64_t *cycles);
+
+/// Where and how the machines diverged
+struct ge_lockstep_report {
+    uint64_t cycles;     ///< Cycles run when the difference was found
+    const char *field;   ///< First different field, "mem" or "return"
+    uint16_t addr;       ///< Address of the first different byte for "mem"
+    uint32_t reference;  ///< Value of the field in the reference
+    uint32_t candidate;  ///< Value of the field in the candidate
+
+    /* state of the reference */
+    uint8_t rSO;
+    uint8_t rSA;
+    uint16_t rPO;
+    enum clock clock;
+};
+
+/// A ge_lockstep_step running a single cycle with ge_run_cycle()
+int ge_lockstep_cycle(struct ge *ge, uint64_t *cycles);
+
+/**
+ * Compare two machines
+ *
+ * @return 0 if the CPU fields and the memory are the same, -1 otherwise
+ *         with the first difference in `report`
+ */
+int ge_lockstep_compare(struct ge *ref, struct ge *cand,
+                        struct ge_lockstep_report *report);
+
+/**
+ * Run two machines in lockstep
+ *
+ * Runs `cand` with `step` and `ref` with ge_run_cycle() for `cycles`
+ * cycles, or until the reference halts, comparing them at the end of
+ * every step. The two machines should start from the same state (e.g.
+ * one forked from the other with ge_fork()).
+ *
+ * @return 0 if the machines never diverged, -1 otherwise with the
+ *         divergence in `report`
+ */
+int ge_lockstep_run(struct ge *ref, struct ge *cand, ge_lockstep_step step,
+                    uint64_t cycles, struct ge_lockstep_report *report);
+
+/// Print a divergence report on one line
+void ge_lockstep_print(const struct ge_lockstep_report *report, FILE *f);
+
+#endif /* LOCKSTEP_H */
@@ -3,7 +3,7 @@
 #include <stdarg.h>
 #include <stdio.h>
 
-static ge_log_type active_log_types = -1; // ~(LOG_CONDS | LOG_STATES);
+_Thread_local ge_log_type ge_active_log_types = -1; // ~(LOG_CONDS | LOG_STATES);
 
 static const char *log_type_name(ge_log_type type)
 {
@@ -25,16 +25,18 @@ static const char *log_type_name(ge_log_type type)
 
 void ge_log_set_active_types(ge_log_type types)
 {
-    active_log_types = types;
+    ge_active_log_types = types;
 }
 
-void ge_log(ge_log_type type, const char *format, ...)
+ge_log_type ge_log_active_types(void)
 {
-    static char line[0x1000];
-    va_list args;
+    return ge_active_log_types;
+}
 
-    if (!(active_log_types & type))
-        return;
+void ge_log_message(ge_log_type type, const char *format, ...)
+{
+    static _Thread_local char line[0x1000];
+    va_list args;
 
     va_start (args, format);
     vsnprintf(line, sizeof(line), format, args);
@@ -43,6 +45,3 @@ void ge_log(ge_log_type type, const char *format, ...)
     printf("  %-7s ]    %s", log_type_name(type), line);
 }
 
-uint8_t ge_log_enabled(ge_log_type type) {
-    return !!(active_log_types & type);
-}
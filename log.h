@@ -29,31 +29,77 @@ enum ge_log_types {
     LOG_CMDS    = 0x800, ///< MSL commands trace
 };
 
+/**
+ * Log types compiled out
+ *
+ * A set of log types which are removed at compile time: messages of these
+ * types are never printed, and the code to produce them is not generated.
+ * Can be set from the build, e.g. `make LOG_DISABLED_TYPES=0xfff`.
+ */
+#ifndef GE_LOG_DISABLED_TYPES
+#define GE_LOG_DISABLED_TYPES 0
+#endif
+
+/**
+ * Active log types
+ *
+ * Per thread, so that emulators running on different threads can log
+ * differently. Do not use directly, use ge_log_set_active_types() and
+ * ge_log_enabled().
+ */
+extern _Thread_local ge_log_type ge_active_log_types;
+
 /**
  * Set active log types
  *
- * Specifies which set of logging messages should be displayed.
+ * Specifies which set of logging messages should be displayed by the
+ * calling thread.
  *
  * @param types A set of log types
  */
 void ge_log_set_active_types(ge_log_type types);
 
+/**
+ * Active log types of the calling thread, to give them to the threads it
+ * starts
+ */
+ge_log_type ge_log_active_types(void);
+
+/**
+ * Check if a log type is enabled
+ *
+ * Evaluates to a constant false if the type has been compiled out.
+ *
+ * @param type The type to check
+ * @returns    true if the logtype mask is enabled
+ */
+#define ge_log_enabled(type) \
+    (!((type) & GE_LOG_DISABLED_TYPES) && !!(ge_active_log_types & (type)))
+
 /**
  * Log message
  *
- * Specifies which set of logging messages should be displayed.
+ * Prints a message if its type is enabled. The arguments are evaluated
+ * only if the message is going to be printed, so it is fine to pass
+ * arguments which are expensive to compute.
  *
  * @param type   The type of the message
  * @param format The printf-style format for the log message
  */
-void ge_log(ge_log_type type, const char *format, ...);
+#define ge_log(type, ...)                           \
+    do {                                            \
+        if (ge_log_enabled(type))                   \
+            ge_log_message((type), __VA_ARGS__);    \
+    } while (0)
 
 /**
- * Check if a log type is enabled
+ * Print a log message
  *
- * @param type The type to check
- * @returns    true if the logtype mask is enabled
+ * Unconditionally prints a message, use ge_log() instead.
+ *
+ * @param type   The type of the message
+ * @param format The printf-style format for the log message
  */
-uint8_t ge_log_enabled(ge_log_type type);
+void ge_log_message(ge_log_type type, const char *format, ...);
 
 #endif /* LOG_H */
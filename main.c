@@ -1,36 +1,358 @@
+#include <signal.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
 #include <unistd.h>
 #include "ge.h"
 #include "console_socket.h"
 #include "log.h"
+#include "trace.h"
+#include "insn.h"
+#include "profile.h"
+#include "output.h"
+
+#define NSEC_PER_SEC 1000000000LL
+
+/* Number of records kept in memory by the binary trace before flushing */
+#define TRACE_RECORDS (1 << 16)
+
+/* In real-time mode the clock is only looked at once every this many
+ * cycles, as a single cycle is way shorter than a sleep can be. */
+#define REALTIME_CHECK_CYCLES 128
+
+/* In real-time mode, if the emulation falls behind by more than this,
+ * the lost time is accounted as drift instead of being caught up. */
+#define REALTIME_MAX_LAG_NS (100 * 1000000LL)
+
+/* Set by SIGINT and SIGTERM when profiling or with output units, to
+ * write the profiles and the pending records */
+static volatile sig_atomic_t interrupted;
+
+enum run_mode {
+    RUN_PULSE,    ///< Sleep CLOCK_PERIOD before every pulse
+    RUN_FAST,     ///< Run as fast as possible
+    RUN_INSN,     ///< Run whole instructions when possible, see insn.h
+    RUN_REALTIME, ///< Pace whole cycles at the speed of the real machine
+};
+
+static void on_interrupt(int sig)
+{
+    interrupted = 1;
+}
+
+static int64_t monotonic_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+static void sleep_until_ns(int64_t deadline)
+{
+    struct timespec ts;
+
+    ts.tv_sec  = deadline / NSEC_PER_SEC;
+    ts.tv_nsec = deadline % NSEC_PER_SEC;
+
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) != 0)
+        ;
+}
+
+static int run_pulse(struct ge *ge)
+{
+    int ret = 0;
+
+    while (!ge->halted && ret == 0 && !interrupted) {
+        /* Delay */
+        usleep(CLOCK_PERIOD);
+        ret = ge_run_pulse(ge);
+    }
+
+    return ret;
+}
+
+static int run_fast(struct ge *ge)
+{
+    int ret = 0;
+
+    while (!ge->halted && ret == 0 && !interrupted)
+        ret = ge_run_cycle(ge);
+
+    return ret;
+}
+
+static int run_insn(struct ge *ge)
+{
+    uint64_t cycles = 0;
+    int ret = 0;
+
+    while (!ge->halted && ret == 0 && !interrupted)
+        ret = ge_run_step(ge, &cycles);
+
+    return ret;
+}
+
+static int run_realtime(struct ge *ge, int64_t cycle_period)
+{
+    int64_t deadline = monotonic_ns();
+    int64_t drift = 0;
+    int64_t lag;
+    uint64_t cycles = 0;
+    int ret = 0;
+
+    while (!ge->halted && ret == 0 && !interrupted) {
+        ret = ge_run_cycle(ge);
+        deadline += cycle_period;
+
+        if (++cycles % REALTIME_CHECK_CYCLES)
+            continue;
+
+        lag = monotonic_ns() - deadline;
+
+        if (lag < 0) {
+            /* ahead of the real machine */
+            sleep_until_ns(deadline);
+        } else if (lag > REALTIME_MAX_LAG_NS) {
+            /* too far behind to catch up, give up on the lost time */
+            drift += lag;
+            deadline += lag;
+            ge_log(LOG_CYCLE,
+                   "real-time: %llu cycles, behind by %lld ns, total drift %lld ns\n",
+                   (unsigned long long)cycles, (long long)lag, (long long)drift);
+        }
+
+        /* otherwise, catch up by not sleeping until back in time */
+    }
+
+    return ret;
+}
+
+static int write_profile(const struct ge_profile *profile, const char *path)
+{
+    FILE *f;
+    int r;
+
+    ge_profile_print(profile, stderr);
+
+    f = fopen(path, "w");
+    if (f == NULL) {
+        perror(path);
+        return -1;
+    }
+
+    r = ge_profile_write_json(profile, f);
+    fclose(f);
+    return r;
+}
+
+static int write_listing(const struct ge_guest_profile *profile, struct ge *ge,
+                         const char *path)
+{
+    FILE *f = fopen(path, "w");
+
+    if (f == NULL) {
+        perror(path);
+        return -1;
+    }
+
+    ge_guest_profile_print(profile, ge, f);
+    fclose(f);
+    return 0;
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+            "usage: %s [-m pulse|fast|insn|realtime] [-p cycle-period-ns] [-t trace-file]\n"
+            "          [-P profile.json] [-L listing] [-3 kind:file] [-4 kind:file]\n"
+            "          [-s console-socket]\n"
+            "\n"
+            "  -m pulse     sleep %d usec before every pulse (default)\n"
+            "  -m fast      run as fast as possible\n"
+            "  -m insn      run as fast as possible, whole instructions at once\n"
+            "  -m realtime  run at the speed of the real machine\n"
+            "  -p ns        cycle period for the realtime mode (default %d)\n"
+            "  -t file      write a binary register trace, see ge-trace\n"
+            "  -P file      profile the states and the timing charts, when\n"
+            "               interrupted print the report and write it as JSON\n"
+            "  -L file      profile the instructions of the program, when\n"
+            "               interrupted write their annotated listing\n"
+            "  -3 kind:file attach a printer or a punch to ST3, writing to file\n"
+            "  -4 kind:file attach a printer or a punch to ST4, writing to file\n"
+            "  -s path      serve the consoles on path (default %s)\n",
+            name, CLOCK_PERIOD, CYCLE_PERIOD_NS, CONSOLE_SOCKET_PATH);
+}
 
 int main(int argc, char *argv[])
 {
-    uint8_t test_program = 0;
+    enum run_mode mode = RUN_PULSE;
+    int64_t cycle_period = CYCLE_PERIOD_NS;
+    const char *trace_path = NULL;
+    const char *profile_path = NULL;
+    const char *listing_path = NULL;
+    const char *console_path = NULL;
+    const char *output_specs[2] = { NULL, NULL };
+    static struct ge_output outputs[2];
+    static struct ge_profile profile;
+    static struct ge_guest_profile guest_profile;
+    struct ge_trace trace;
+    FILE *trace_file = NULL;
     struct ge ge130;
     int ret;
+    int opt;
+    int i;
+
+    while ((opt = getopt(argc, argv, "m:p:t:P:L:3:4:s:h")) != -1) {
+        switch (opt) {
+            case 'm':
+                if (strcmp(optarg, "pulse") == 0)
+                    mode = RUN_PULSE;
+                else if (strcmp(optarg, "fast") == 0)
+                    mode = RUN_FAST;
+                else if (strcmp(optarg, "insn") == 0)
+                    mode = RUN_INSN;
+                else if (strcmp(optarg, "realtime") == 0)
+                    mode = RUN_REALTIME;
+                else {
+                    usage(argv[0]);
+                    return 1;
+                }
+                break;
+
+            case 'p':
+                cycle_period = strtoll(optarg, NULL, 0);
+                if (cycle_period <= 0) {
+                    usage(argv[0]);
+                    return 1;
+                }
+                break;
+
+            case 't':
+                trace_path = optarg;
+                break;
+
+            case 'P':
+                profile_path = optarg;
+                break;
+
+            case 'L':
+                listing_path = optarg;
+                break;
+
+            case '3':
+            case '4':
+                output_specs[opt - '3'] = optarg;
+                break;
+
+            case 's':
+                console_path = optarg;
+                break;
+
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
 
     ge_init(&ge130);
 
-    ret = console_socket_register(&ge130);
-    if (ret != 0)
-        return ret;
+    if (trace_path) {
+        trace_file = fopen(trace_path, "wb");
+        if (trace_file == NULL) {
+            perror(trace_path);
+            return 1;
+        }
+
+        if (ge_trace_init(&trace, TRACE_RECORDS, TRACE_FLUSH_SELF) != 0 ||
+            ge_trace_set_file(&trace, trace_file) != 0) {
+            fprintf(stderr, "cannot set up the trace\n");
+            return 1;
+        }
 
-    while(1) {
+        ge_set_trace(&ge130, &trace);
+    }
+
+    if (profile_path) {
+        ge_profile_init(&profile);
+        ge_set_profile(&ge130, &profile);
+    }
+
+    if (listing_path) {
+        ge_guest_profile_init(&guest_profile);
+        ge_set_guest_profile(&ge130, &guest_profile);
+    }
+
+    for (i = 0; i < 2; i++) {
+        enum ge_output_kind kind;
+        const char *path;
+
+        if (output_specs[i] == NULL)
+            continue;
+
+        if (ge_output_parse(output_specs[i], &kind, &path) != 0) {
+            usage(argv[0]);
+            return 1;
+        }
+
+        if (ge_output_open(&outputs[i], kind, path) != 0) {
+            perror(path);
+            return 1;
+        }
+
+        ge_output_register(&ge130, &outputs[i], i == 0 ? &ge130.ST3 : &ge130.ST4);
+    }
+
+    /* stop cleanly, at least to remove the console socket */
+    signal(SIGINT, on_interrupt);
+    signal(SIGTERM, on_interrupt);
+
+    ret = console_socket_register(&ge130, console_path);
+    if (ret != 0) {
+        fprintf(stderr, "cannot serve the consoles on %s\n",
+                console_path ? console_path : CONSOLE_SOCKET_PATH);
+        return 1;
+    }
+
+    while (!interrupted) {
         /* load with memory / and or setup peripherics */
         ge_clear(&ge130);
         ge_start(&ge130);
 
-        while (!ge130.halted || ret != 0) {
-            /* Delay */
-            usleep(CLOCK_PERIOD);
-            ret = ge_run_pulse(&ge130);
+        switch (mode) {
+            case RUN_PULSE:    ret = run_pulse(&ge130);                  break;
+            case RUN_FAST:     ret = run_fast(&ge130);                   break;
+            case RUN_INSN:     ret = run_insn(&ge130);                   break;
+            case RUN_REALTIME: ret = run_realtime(&ge130, cycle_period); break;
         }
 
+        if (trace_file)
+            ge_trace_flush(&trace);
+
+        if (interrupted)
+            break;
+
         printf(" *** RESTART *** ");
         sleep(1);
     }
 
+    if (listing_path && write_listing(&guest_profile, &ge130, listing_path) != 0)
+        ret = 1;
+
     ge_deinit(&ge130);
+
+    for (i = 0; i < 2; i++)
+        if (ge_output_close(&outputs[i]) != 0)
+            ret = 1;
+
+    if (trace_file) {
+        ge_trace_deinit(&trace);
+        fclose(trace_file);
+    }
+
+    if (profile_path && write_profile(&profile, profile_path) != 0)
+        return 1;
+
     return ret;
 }
@@ -0,0 +1,180 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "mem.h"
+#include "log.h"
+#include "signals.h"
+
+static const uint8_t zero_page[MEM_PAGE_SIZE];
+
+static void page_unref(struct ge_mem_page *page)
+{
+    if (page && atomic_fetch_sub(&page->refs, 1) == 1)
+        free(page);
+}
+
+struct ge_mem_page *ge_mem_page_for_write(struct ge *ge, uint8_t n)
+{
+    struct ge_mem_page *page = ge->pages->page[n];
+    struct ge_mem_page *copy;
+
+    if (page && atomic_load(&page->refs) == 1)
+        return page;
+
+    copy = malloc(sizeof(*copy));
+    if (copy == NULL) {
+        ge_log(LOG_ERR, "cannot allocate memory page %02x\n", n);
+        return NULL;
+    }
+
+    atomic_init(&copy->refs, 1);
+    memcpy(copy->data, page ? page->data : zero_page, MEM_PAGE_SIZE);
+
+    page_unref(page);
+    ge->pages->page[n] = copy;
+    return copy;
+}
+
+const uint8_t *ge_mem_page_data(struct ge *ge, uint8_t n)
+{
+    if (ge->pages == NULL)
+        return &ge->mem[n * MEM_PAGE_SIZE];
+
+    return ge->pages->page[n] ? ge->pages->page[n]->data : zero_page;
+}
+
+int ge_mem_load(struct ge *ge, uint16_t addr, const uint8_t *data, size_t size)
+{
+    struct ge_mem_page *page;
+    size_t count;
+
+    if (size > (size_t)MEM_SIZE - addr)
+        return -1;
+
+    if (ge->pages == NULL) {
+        memcpy(&ge->mem[addr], data, size);
+        return 0;
+    }
+
+    while (size) {
+        count = MEM_PAGE_SIZE - addr % MEM_PAGE_SIZE;
+        if (count > size)
+            count = size;
+
+        page = ge_mem_page_for_write(ge, addr / MEM_PAGE_SIZE);
+        if (page == NULL)
+            return -1;
+
+        memcpy(&page->data[addr % MEM_PAGE_SIZE], data, count);
+        addr += count;
+        data += count;
+        size -= count;
+    }
+
+    return 0;
+}
+
+void ge_mem_clear(struct ge *ge)
+{
+    int i;
+
+    if (ge->pages == NULL) {
+        memset(ge->mem, 0, MEM_SIZE);
+        return;
+    }
+
+    for (i = 0; i < MEM_PAGES; i++) {
+        page_unref(ge->pages->page[i]);
+        ge->pages->page[i] = NULL;
+    }
+}
+
+static void mem_free_pages(struct ge *ge)
+{
+    ge_mem_clear(ge);
+    free(ge->pages);
+    ge->pages = NULL;
+}
+
+int ge_mem_use_pages(struct ge *ge)
+{
+    struct ge_mem_pages *pages;
+    int i;
+
+    if (ge->pages)
+        return 0;
+
+    pages = calloc(1, sizeof(*pages));
+    if (pages == NULL)
+        return -1;
+
+    ge->pages = pages;
+
+    /* pages of zeros are left unallocated */
+    for (i = 0; i < MEM_PAGES; i++) {
+        if (memcmp(&ge->mem[i * MEM_PAGE_SIZE], zero_page, MEM_PAGE_SIZE) == 0)
+            continue;
+
+        /* the array still has the whole content */
+        if (ge_mem_page_for_write(ge, i) == NULL) {
+            mem_free_pages(ge);
+            return -1;
+        }
+
+        memcpy(pages->page[i]->data, &ge->mem[i * MEM_PAGE_SIZE], MEM_PAGE_SIZE);
+    }
+
+    return 0;
+}
+
+void ge_mem_release(struct ge *ge)
+{
+    int i;
+
+    if (ge->pages == NULL)
+        return;
+
+    /* the content of the pages goes back in the array */
+    for (i = 0; i < MEM_PAGES; i++)
+        memcpy(&ge->mem[i * MEM_PAGE_SIZE], ge_mem_page_data(ge, i), MEM_PAGE_SIZE);
+
+    mem_free_pages(ge);
+}
+
+int ge_fork(struct ge *dst, struct ge *src)
+{
+    const size_t mem_start = offsetof(struct ge, mem);
+    const size_t mem_end = mem_start + sizeof(src->mem);
+    struct ge_mem_pages *pages = NULL;
+    int i;
+
+    if (src->pages) {
+        pages = malloc(sizeof(*pages));
+        if (pages == NULL)
+            return -1;
+
+        *pages = *src->pages;
+        for (i = 0; i < MEM_PAGES; i++) {
+            if (pages->page[i])
+                atomic_fetch_add(&pages->page[i]->refs, 1);
+        }
+    }
+
+    /* the memory array is skipped when it is not used */
+    memcpy(dst, src, mem_start);
+    memcpy((uint8_t *)dst + mem_end, (uint8_t *)src + mem_end, sizeof(*src) - mem_end);
+
+    if (pages == NULL)
+        memcpy(dst->mem, src->mem, MEM_SIZE);
+
+    dst->pages = pages;
+    dst->peri = NULL;
+    dst->peri_clocks = 0;
+    dst->trace = NULL;
+    dst->snapshot_sections = NULL;
+    dst->profile = NULL;
+    dst->profile_rows = NULL;
+    dst->guest_profile = NULL;
+    knots_changed(dst);
+    return 0;
+}
@@ -0,0 +1,111 @@
+/**
+ * @file  mem.h
+ * @brief Memory of the emulated system
+ *
+ * By default the memory is the `mem` array embedded in struct ge. A
+ * machine can be switched to a paged backend with ge_mem_use_pages():
+ * the memory is then split in pages of MEM_PAGE_SIZE bytes, shared by
+ * reference between the machines forked with ge_fork() and copied the
+ * first time one of them writes in a page. Pages never written are not
+ * allocated, and read as zeros.
+ *
+ * With the paged backend the `mem` array is not used, and the memory
+ * should only be accessed with the functions below.
+ */
+
+#ifndef MEM_H
+#define MEM_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "ge.h"
+
+#define MEM_PAGE_SIZE 256
+#define MEM_PAGES     (MEM_SIZE / MEM_PAGE_SIZE)
+
+struct ge_mem_page {
+    atomic_int refs; ///< Number of machines sharing the page
+    uint8_t data[MEM_PAGE_SIZE];
+};
+
+/// Page table of a machine using the paged backend
+struct ge_mem_pages {
+    struct ge_mem_page *page[MEM_PAGES]; ///< NULL if never written
+};
+
+/// Get the page for writing, unsharing or allocating it, NULL on errors
+struct ge_mem_page *ge_mem_page_for_write(struct ge *ge, uint8_t page);
+
+/// Read a character of memory
+static inline uint8_t ge_mem_read(struct ge *ge, uint16_t addr)
+{
+    struct ge_mem_page *page;
+
+    if (ge->pages == NULL)
+        return ge->mem[addr];
+
+    page = ge->pages->page[addr / MEM_PAGE_SIZE];
+    return page ? page->data[addr % MEM_PAGE_SIZE] : 0;
+}
+
+/// Write a character of memory
+static inline void ge_mem_write(struct ge *ge, uint16_t addr, uint8_t value)
+{
+    struct ge_mem_page *page;
+
+    if (ge->pages == NULL) {
+        ge->mem[addr] = value;
+        return;
+    }
+
+    page = ge_mem_page_for_write(ge, addr / MEM_PAGE_SIZE);
+    if (page)
+        page->data[addr % MEM_PAGE_SIZE] = value;
+}
+
+/**
+ * The content of a page
+ *
+ * Only valid until the next write in the machine.
+ */
+const uint8_t *ge_mem_page_data(struct ge *ge, uint8_t page);
+
+/// Copy `size` bytes in memory starting from `addr`, returns 0 on success
+int ge_mem_load(struct ge *ge, uint16_t addr, const uint8_t *data, size_t size);
+
+/// Set all the memory to zero
+void ge_mem_clear(struct ge *ge);
+
+/**
+ * Switch to the paged backend
+ *
+ * The content of the memory is moved in pages. Does nothing if the
+ * machine already uses the paged backend.
+ *
+ * @return 0 on success, -1 on errors
+ */
+int ge_mem_use_pages(struct ge *ge);
+
+/**
+ * Release the pages of the machine, switching back to the `mem` array
+ *
+ * The content of the pages is copied back in the array.
+ */
+void ge_mem_release(struct ge *ge);
+
+/**
+ * Fork a machine
+ *
+ * Copies the whole state of `src` in `dst`. If `src` uses the paged
+ * backend its pages are shared with `dst` and copied on write, otherwise
+ * the `mem` array is copied.
+ *
+ * Peripherals, trace, snapshot sections and profiles are bound to the
+ * original machine and are not inherited: `dst` starts without any.
+ *
+ * @return 0 on success, -1 on errors
+ */
+int ge_fork(struct ge *dst, struct ge *src);
+
+#endif /* MEM_H */
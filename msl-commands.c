@@ -12,42 +12,42 @@
 /* Commands To Load The Registers */
 /* ------------------------------ */
 
-static void CO00(struct ge* ge) { ge->rPO = NI_knot(ge); }
-static void CO01(struct ge* ge) { ge->rV1 = NI_knot(ge); }
-static void CO02(struct ge* ge) { ge->rV2 = NI_knot(ge); }
-static void CO03(struct ge* ge) { ge->rV3 = NI_knot(ge); }
-static void CO04(struct ge* ge) { ge->rV4 = NI_knot(ge); }
+static void CO00(struct ge* ge) { ge->rPO = NI_knot(ge); NO_changed(ge); }
+static void CO01(struct ge* ge) { ge->rV1 = NI_knot(ge); NO_changed(ge); }
+static void CO02(struct ge* ge) { ge->rV2 = NI_knot(ge); NO_changed(ge); }
+static void CO03(struct ge* ge) { ge->rV3 = NI_knot(ge); NO_changed(ge); }
+static void CO04(struct ge* ge) { ge->rV4 = NI_knot(ge); NO_changed(ge); }
 
 static void CI00(struct ge* ge) { CO00(ge); }
 static void CI01(struct ge* ge) { CO01(ge); }
 static void CI02(struct ge* ge) { CO02(ge); }
 static void CI03(struct ge* ge) { CO03(ge); }
 static void CI04(struct ge* ge) { CO04(ge); }
-static void CI05(struct ge* ge) { ge->rL1 = NI_knot(ge); }
-static void CI06(struct ge* ge) { ge->rL2 = NI_knot(ge) & 0x00ff; }
-static void CI07(struct ge* ge) { ge->rL3 = NI_knot(ge); }
+static void CI05(struct ge* ge) { ge->rL1 = NI_knot(ge); NO_changed(ge); }
+static void CI06(struct ge* ge) { ge->rL2 = NI_knot(ge) & 0x00ff; NO_changed(ge); }
+static void CI07(struct ge* ge) { ge->rL3 = NI_knot(ge); NO_changed(ge); }
 static void CI08(struct ge* ge) { ge->rFO = (NI_knot(ge) & 0x00ff); }
-static void CI09(struct ge* ge) { ge->rRI = (NI_knot(ge) & 0xff00) >> 8; }
+static void CI09(struct ge* ge) { ge->rRI = (NI_knot(ge) & 0xff00) >> 8; NO_changed(ge); }
 
 /* NO Knot Selection Commands */
 /* -------------------------- */
 
-static void CO10(struct ge* ge) { ge->kNO.cmd = KNOT_PO_IN_NO; }
-static void CO11(struct ge* ge) { ge->kNO.cmd = KNOT_V1_IN_NO; }
-static void CO12(struct ge* ge) { ge->kNO.cmd = KNOT_V2_IN_NO; }
-static void CO13(struct ge* ge) { ge->kNO.cmd = KNOT_V3_IN_NO; }
-static void CO14(struct ge* ge) { ge->kNO.cmd = KNOT_V4_IN_NO; }
-static void CO16(struct ge* ge) { ge->kNO.cmd = KNOT_L2_IN_NO; }
-static void CO18(struct ge *ge) { ge->kNO.forcings = KNOT_FORCING_NO_21; }
+static void CO10(struct ge* ge) { ge->kNO.cmd = KNOT_PO_IN_NO; NO_changed(ge); }
+static void CO11(struct ge* ge) { ge->kNO.cmd = KNOT_V1_IN_NO; NO_changed(ge); }
+static void CO12(struct ge* ge) { ge->kNO.cmd = KNOT_V2_IN_NO; NO_changed(ge); }
+static void CO13(struct ge* ge) { ge->kNO.cmd = KNOT_V3_IN_NO; NO_changed(ge); }
+static void CO14(struct ge* ge) { ge->kNO.cmd = KNOT_V4_IN_NO; NO_changed(ge); }
+static void CO16(struct ge* ge) { ge->kNO.cmd = KNOT_L2_IN_NO; NO_changed(ge); }
+static void CO18(struct ge *ge) { ge->kNO.forcings = KNOT_FORCING_NO_21; NO_changed(ge); }
 
 static void CI11(struct ge* ge) { CO11(ge);                          }
 static void CI12(struct ge* ge) { CO12(ge);                          }
-static void CI15(struct ge* ge) { ge->kNO.cmd = KNOT_L1_IN_NO;       }
+static void CI15(struct ge* ge) { ge->kNO.cmd = KNOT_L1_IN_NO; NO_changed(ge); }
 static void CI16(struct ge* ge) { CO16(ge);                          }
-static void CI17(struct ge* ge) { ge->kNO.cmd = KNOT_L3_IN_NO;       }
-static void CI19(struct ge* ge) { ge->kNO.force_mode = KNOT_FORCING_NO_43; }
-static void CI20(struct ge* ge) { ge->kNO.cmd = KNOT_AM_IN_NO;       }
-static void CI21(struct ge* ge) { ge->kNO.cmd = KNOT_RI_IN_NO_43;    }
+static void CI17(struct ge* ge) { ge->kNO.cmd = KNOT_L3_IN_NO; NO_changed(ge); }
+static void CI19(struct ge* ge) { ge->kNO.force_mode = KNOT_FORCING_NO_43; NO_changed(ge); }
+static void CI20(struct ge* ge) { ge->kNO.cmd = KNOT_AM_IN_NO; NO_changed(ge); }
+static void CI21(struct ge* ge) { ge->kNO.cmd = KNOT_RI_IN_NO_43; NO_changed(ge); }
 
 
 /* VO, BO, RO Loading Commands */
@@ -59,16 +59,19 @@ static void CO35(struct ge* ge) { /* "reset int. error"? (cpu fo. 105) */ }
 
 static void CI32(struct ge* ge) {
     ge->rRO = NO_knot(ge) >> 8;
+    NI_changed(ge);
     ge->TO50_did_CI32_or_CI33 = 1;
 }
 
 static void CI33(struct ge* ge) {
     ge->rRO = NO_knot(ge) & 0x00ff;
+    NI_changed(ge);
     ge->TO50_did_CI32_or_CI33 = 1;
 }
 
 static void CI34(struct ge* ge) {
     ge->rRO = NE_knot(ge);
+    NI_changed(ge);
 }
 
 static void CI38(struct ge *ge)
@@ -104,7 +107,7 @@ static void CI39(struct ge *ge)
 /* ------------------------------------ */
 
 static void CO40(struct ge* ge) { ge->counting_network.cmds.decresing = 1; };
-static void CO41(struct ge* ge) { ge->counting_network.cmds.from_zero = 1; };
+static void CO41(struct ge* ge) { ge->counting_network.cmds.from_zero = 1; NI_changed(ge); };
 static void CO48(struct ge* ge)
 {
     /* most probably incorrect, "set urpe/urpu" (cpu fo. 106) */
@@ -125,16 +128,16 @@ static void CI41(struct ge *ge) { CO41(ge); }
 /* NI Knot Selection Commands */
 /* -------------------------- */
 
-static void CI60(struct ge *ge) { ge->kNI.ni4 = NS_RO2; }
-static void CI61(struct ge *ge) { ge->kNI.ni3 = NS_RO2; }
-static void CI62(struct ge *ge) { ge->kNI.ni2 = NS_RO2; }
-static void CI63(struct ge *ge) { ge->kNI.ni1 = NS_RO2; }
-static void CI64(struct ge *ge) { ge->kNI.ni4 = NS_RO1; }
-static void CI65(struct ge *ge) { ge->kNI.ni3 = NS_RO1; }
-static void CI66(struct ge *ge) { ge->kNI.ni2 = NS_RO1; }
-static void CI67(struct ge *ge) { ge->kNI.ni1 = NS_RO1; }
-static void CI68(struct ge *ge) { ge->kNI.ni4 = NS_UA2; ge->kNI.ni3 = NS_UA1; }
-static void CI69(struct ge *ge) { ge->kNI.ni2 = NS_UA2; ge->kNI.ni1 = NS_UA1; }
+static void CI60(struct ge *ge) { ge->kNI.ni4 = NS_RO2; NI_changed(ge); }
+static void CI61(struct ge *ge) { ge->kNI.ni3 = NS_RO2; NI_changed(ge); }
+static void CI62(struct ge *ge) { ge->kNI.ni2 = NS_RO2; NI_changed(ge); }
+static void CI63(struct ge *ge) { ge->kNI.ni1 = NS_RO2; NI_changed(ge); }
+static void CI64(struct ge *ge) { ge->kNI.ni4 = NS_RO1; NI_changed(ge); }
+static void CI65(struct ge *ge) { ge->kNI.ni3 = NS_RO1; NI_changed(ge); }
+static void CI66(struct ge *ge) { ge->kNI.ni2 = NS_RO1; NI_changed(ge); }
+static void CI67(struct ge *ge) { ge->kNI.ni1 = NS_RO1; NI_changed(ge); }
+static void CI68(struct ge *ge) { ge->kNI.ni4 = NS_UA2; ge->kNI.ni3 = NS_UA1; NI_changed(ge); }
+static void CI69(struct ge *ge) { ge->kNI.ni2 = NS_UA2; ge->kNI.ni1 = NS_UA1; NI_changed(ge); }
 
 /* Commands To Set And Reset FF Of Condition */
 /* ----------------------------------------- */
@@ -171,14 +174,14 @@ static void CI89(struct ge* ge) { ge->ALTO = 1; }
 /* Commands To Force In NO Knot */
 /* ---------------------------- */
 
-static void CO90(struct ge *ge) { SET_BIT(ge->kNO.forcings, 0); }
-static void CO91(struct ge *ge) { SET_BIT(ge->kNO.forcings, 1); }
-static void CO92(struct ge *ge) { SET_BIT(ge->kNO.forcings, 2); }
-static void CO93(struct ge *ge) { SET_BIT(ge->kNO.forcings, 3); }
-static void CO94(struct ge *ge) { SET_BIT(ge->kNO.forcings, 4); }
-static void CO95(struct ge *ge) { SET_BIT(ge->kNO.forcings, 5); }
-static void CO96(struct ge *ge) { SET_BIT(ge->kNO.forcings, 6); }
-static void CO97(struct ge *ge) { SET_BIT(ge->kNO.forcings, 7); }
+static void CO90(struct ge *ge) { SET_BIT(ge->kNO.forcings, 0); NO_changed(ge); }
+static void CO91(struct ge *ge) { SET_BIT(ge->kNO.forcings, 1); NO_changed(ge); }
+static void CO92(struct ge *ge) { SET_BIT(ge->kNO.forcings, 2); NO_changed(ge); }
+static void CO93(struct ge *ge) { SET_BIT(ge->kNO.forcings, 3); NO_changed(ge); }
+static void CO94(struct ge *ge) { SET_BIT(ge->kNO.forcings, 4); NO_changed(ge); }
+static void CO95(struct ge *ge) { SET_BIT(ge->kNO.forcings, 5); NO_changed(ge); }
+static void CO96(struct ge *ge) { SET_BIT(ge->kNO.forcings, 6); NO_changed(ge); }
+static void CO97(struct ge *ge) { SET_BIT(ge->kNO.forcings, 7); NO_changed(ge); }
 
 /* Commands For External Operations */
 /* -------------------------------- */
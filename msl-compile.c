@@ -0,0 +1,298 @@
+/**
+ * @file  msl-compile.c
+ * @brief Timing charts compiler
+ *
+ * Reads the timing charts of msl-states.c and writes, on the standard
+ * output, one C function for every clock of every chart. The function
+ * runs the rows of that clock in order, calling the commands and the
+ * conditions directly instead of through the pointers of the chart.
+ *
+ * The output is included by msl-timings.c, in the same translation unit
+ * of the commands and of the conditions, so that the compiler can inline
+ * them. See msl_run_state() for how it is used.
+ *
+ * Usage: msl-compile msl-states.c > msl-compiled.c
+ */
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ge.h"
+
+#define MAX_NAME  64
+#define MAX_ROWS  256
+#define MAX_CHARTS 256
+
+static const char *clocks[END_OF_STATUS + 1] = {
+    #define X(name) [name] = #name,
+    ENUMERATE_CLOCKS
+    #undef X
+};
+
+struct row {
+    int clock;
+    char command[MAX_NAME];
+    char condition[MAX_NAME];
+    char additional[MAX_NAME];
+};
+
+struct chart {
+    char name[MAX_NAME];
+    struct row rows[MAX_ROWS];
+    int count;
+};
+
+static struct chart charts[MAX_CHARTS];
+static int charts_count;
+
+static char *read_file(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    char *buf;
+    long size;
+
+    if (f == NULL)
+        return NULL;
+
+    fseek(f, 0, SEEK_END);
+    size = ftell(f);
+    rewind(f);
+
+    buf = calloc(1, size + 1);
+    if (buf && fread(buf, 1, size, f) != (size_t)size) {
+        free(buf);
+        buf = NULL;
+    }
+
+    fclose(f);
+    return buf;
+}
+
+/* Replace the comments with spaces */
+static void strip_comments(char *s)
+{
+    char *end;
+
+    for (; *s; s++) {
+        if (s[0] == '/' && s[1] == '*') {
+            end = strstr(s + 2, "*/");
+            end = end ? end + 2 : s + strlen(s);
+        } else if (s[0] == '/' && s[1] == '/') {
+            end = strchr(s, '\n');
+            end = end ? end : s + strlen(s);
+        } else {
+            continue;
+        }
+
+        memset(s, ' ', end - s);
+        s = end - 1;
+    }
+}
+
+static int clock_index(const char *name)
+{
+    int i;
+
+    for (i = 0; i < END_OF_STATUS; i++) {
+        if (strcmp(clocks[i], name) == 0)
+            return i;
+    }
+
+    return -1;
+}
+
+/* Split a row "{ A, B, C, D }" in its fields, returns their number */
+static int parse_fields(const char *s, const char *end, char fields[4][MAX_NAME])
+{
+    int n = 0, len;
+
+    memset(fields, 0, 4 * MAX_NAME);
+
+    while (s < end && n < 4) {
+        while (s < end && (isspace((unsigned char)*s) || *s == ','))
+            s++;
+
+        for (len = 0; s + len < end && (isalnum((unsigned char)s[len]) || s[len] == '_'); len++)
+            ;
+
+        if (len == 0 || len >= MAX_NAME)
+            break;
+
+        memcpy(fields[n++], s, len);
+        s += len;
+    }
+
+    return n;
+}
+
+static int parse_chart(struct chart *chart, const char *s, const char *end)
+{
+    char fields[4][MAX_NAME];
+    const char *close;
+    struct row *row;
+    int n;
+
+    while ((s = memchr(s, '{', end - s)) != NULL) {
+        close = memchr(s, '}', end - s);
+        if (close == NULL)
+            return -1;
+
+        n = parse_fields(s + 1, close, fields);
+        s = close + 1;
+
+        if (n >= 1 && strcmp(fields[0], "END_OF_STATUS") == 0)
+            return 0;
+
+        if (n < 2 || chart->count == MAX_ROWS) {
+            fprintf(stderr, "%s: bad row %d\n", chart->name, chart->count);
+            return -1;
+        }
+
+        row = &chart->rows[chart->count++];
+        row->clock = clock_index(fields[0]);
+        if (row->clock < 0) {
+            fprintf(stderr, "%s: unknown clock %s\n", chart->name, fields[0]);
+            return -1;
+        }
+
+        strcpy(row->command, fields[1]);
+        if (n > 2 && strcmp(fields[2], "0") != 0 && strcmp(fields[2], "NULL") != 0)
+            strcpy(row->condition, fields[2]);
+        if (n > 3 && strcmp(fields[3], "0") != 0 && strcmp(fields[3], "NULL") != 0)
+            strcpy(row->additional, fields[3]);
+    }
+
+    fprintf(stderr, "%s: missing END_OF_STATUS\n", chart->name);
+    return -1;
+}
+
+static int parse(char *s)
+{
+    static const char decl[] = "struct msl_timing_chart";
+    struct chart *chart;
+    char *name, *end;
+    int len;
+
+    while ((s = strstr(s, decl)) != NULL) {
+        s += sizeof(decl) - 1;
+
+        name = s;
+        while (isspace((unsigned char)*name))
+            name++;
+        for (len = 0; isalnum((unsigned char)name[len]) || name[len] == '_'; len++)
+            ;
+
+        /* only the definitions of the charts, i.e. "name[] = {" */
+        s = name + len;
+        if (len == 0 || len >= MAX_NAME || strncmp(s, "[]", 2) != 0)
+            continue;
+
+        s = strchr(s, '{');
+        end = s ? strstr(s, "};") : NULL;
+        if (end == NULL)
+            return -1;
+
+        if (charts_count == MAX_CHARTS)
+            return -1;
+
+        chart = &charts[charts_count++];
+        memcpy(chart->name, name, len);
+
+        if (parse_chart(chart, s + 1, end) != 0)
+            return -1;
+
+        s = end;
+    }
+
+    return 0;
+}
+
+/* `n` is the index of the row in the rows of the chart grouped by clock,
+ * as prepared by msl_init() */
+static void emit_row(const struct row *row, int n)
+{
+    printf("    MSL_ROW(%d);\n", n);
+
+    if (row->additional[0] && row->condition[0])
+        printf("    if (MSL_ADDITIONAL(%d, %s) && MSL_CONDITION(%d, %s))\n    ",
+               n, row->additional, n, row->condition);
+    else if (row->additional[0])
+        printf("    if (MSL_ADDITIONAL(%d, %s))\n    ", n, row->additional);
+    else if (row->condition[0])
+        printf("    if (MSL_CONDITION(%d, %s))\n    ", n, row->condition);
+
+    printf("    MSL_COMMAND(%d, %s);\n", n, row->command);
+}
+
+static void emit_chart(const struct chart *chart)
+{
+    int c, i, n = 0, any;
+
+    for (c = 0; c < END_OF_STATUS; c++) {
+        any = 0;
+
+        for (i = 0; i < chart->count; i++) {
+            if (chart->rows[i].clock != c)
+                continue;
+
+            if (!any)
+                printf("static void %s_%s(struct ge *ge)\n{\n", chart->name, clocks[c]);
+
+            emit_row(&chart->rows[i], n++);
+            any = 1;
+        }
+
+        if (any)
+            printf("}\n\n");
+    }
+
+    printf("static const msl_clock_cb %s_compiled[END_OF_STATUS] = {\n", chart->name);
+    for (c = 0; c < END_OF_STATUS; c++) {
+        for (i = 0; i < chart->count; i++) {
+            if (chart->rows[i].clock == c) {
+                printf("    [%s] = %s_%s,\n", clocks[c], chart->name, clocks[c]);
+                break;
+            }
+        }
+    }
+    printf("};\n\n");
+}
+
+int main(int argc, char *argv[])
+{
+    char *source;
+    int i;
+
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s msl-states.c\n", argv[0]);
+        return 1;
+    }
+
+    source = read_file(argv[1]);
+    if (source == NULL) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    strip_comments(source);
+
+    if (parse(source) != 0) {
+        fprintf(stderr, "%s: cannot parse the timing charts\n", argv[1]);
+        return 1;
+    }
+
+    printf("/* Generated by msl-compile from %s, do not edit */\n\n", argv[1]);
+
+    for (i = 0; i < charts_count; i++)
+        emit_chart(&charts[i]);
+
+    printf("const struct msl_compiled_chart msl_compiled_charts[] = {\n");
+    for (i = 0; i < charts_count; i++)
+        printf("    { %s, %s_compiled },\n", charts[i].name, charts[i].name);
+    printf("    { 0, 0 }\n};\n");
+
+    free(source);
+    return 0;
+}
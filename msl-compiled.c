@@ -0,0 +1,2098 @@
+/* Generated by msl-compile from msl-states.c, do not edit */
+
+static void state_80_TO30(struct ge *ge)
+{
+    MSL_ROW(0);
+    if (MSL_ADDITIONAL(0, DI28A0))
+        MSL_COMMAND(0, CI19);
+    MSL_ROW(1);
+    if (MSL_CONDITION(1, state_80_TO30_CO96))
+        MSL_COMMAND(1, CO96);
+    MSL_ROW(2);
+    if (MSL_CONDITION(2, state_80_TO30_CO97))
+        MSL_COMMAND(2, CO97);
+}
+
+static void state_80_TO40(struct ge *ge)
+{
+    MSL_ROW(3);
+    MSL_COMMAND(3, CO00);
+    MSL_ROW(4);
+    MSL_COMMAND(4, CO02);
+}
+
+static void state_80_TO50(struct ge *ge)
+{
+    MSL_ROW(5);
+    if (MSL_ADDITIONAL(5, DI28A0))
+        MSL_COMMAND(5, CI32);
+}
+
+static void state_80_TO70(struct ge *ge)
+{
+    MSL_ROW(6);
+    MSL_COMMAND(6, CI62);
+    MSL_ROW(7);
+    if (MSL_ADDITIONAL(7, DI28B0))
+        MSL_COMMAND(7, CI67);
+}
+
+static void state_80_TI05(struct ge *ge)
+{
+    MSL_ROW(8);
+    if (MSL_ADDITIONAL(8, DI28B0))
+        MSL_COMMAND(8, CI05);
+    MSL_ROW(9);
+    MSL_COMMAND(9, CI08);
+}
+
+static void state_80_TI06(struct ge *ge)
+{
+    MSL_ROW(10);
+    MSL_COMMAND(10, CI76);
+    MSL_ROW(11);
+    MSL_COMMAND(11, CI80);
+    MSL_ROW(12);
+    MSL_COMMAND(12, CI81);
+    MSL_ROW(13);
+    MSL_COMMAND(13, CI82);
+    MSL_ROW(14);
+    if (MSL_CONDITION(14, not_AINI))
+        MSL_COMMAND(14, CU01);
+    MSL_ROW(15);
+    if (MSL_CONDITION(15, AINI))
+        MSL_COMMAND(15, CU03);
+    MSL_ROW(16);
+    if (MSL_CONDITION(16, not_AINI))
+        MSL_COMMAND(16, CU05);
+    MSL_ROW(17);
+    MSL_COMMAND(17, CU06);
+}
+
+static const msl_clock_cb state_80_compiled[END_OF_STATUS] = {
+    [TO30] = state_80_TO30,
+    [TO40] = state_80_TO40,
+    [TO50] = state_80_TO50,
+    [TO70] = state_80_TO70,
+    [TI05] = state_80_TI05,
+    [TI06] = state_80_TI06,
+};
+
+static void state_E2_E3_TO10(struct ge *ge)
+{
+    MSL_ROW(0);
+    MSL_COMMAND(0, CO10);
+    MSL_ROW(1);
+    if (MSL_ADDITIONAL(1, DI12A0))
+        MSL_COMMAND(1, CO41);
+}
+
+static void state_E2_E3_TO25(struct ge *ge)
+{
+    MSL_ROW(2);
+    if (MSL_ADDITIONAL(2, DI12A0))
+        MSL_COMMAND(2, CO30);
+}
+
+static void state_E2_E3_TO40(struct ge *ge)
+{
+    MSL_ROW(3);
+    if (MSL_ADDITIONAL(3, DI18B0))
+        MSL_COMMAND(3, CO02);
+}
+
+static void state_E2_E3_TO70(struct ge *ge)
+{
+    MSL_ROW(4);
+    if (MSL_ADDITIONAL(4, DI12A0))
+        MSL_COMMAND(4, CI67);
+    MSL_ROW(5);
+    if (MSL_ADDITIONAL(5, DI12A0))
+        MSL_COMMAND(5, CI62);
+}
+
+static void state_E2_E3_TO80(struct ge *ge)
+{
+    MSL_ROW(6);
+    if (MSL_CONDITION(6, state_E2_E3_TO80_CI89))
+        MSL_COMMAND(6, CI89);
+}
+
+static void state_E2_E3_TI05(struct ge *ge)
+{
+    MSL_ROW(7);
+    MSL_COMMAND(7, CI08);
+}
+
+static void state_E2_E3_TI06(struct ge *ge)
+{
+    MSL_ROW(8);
+    MSL_COMMAND(8, CI80);
+    MSL_ROW(9);
+    if (MSL_CONDITION(9, state_E2_E3_TI06_CI82))
+        MSL_COMMAND(9, CI82);
+    MSL_ROW(10);
+    MSL_COMMAND(10, CI83);
+    MSL_ROW(11);
+    if (MSL_CONDITION(11, state_E2_E3_TI06_CU04))
+        MSL_COMMAND(11, CU04);
+    MSL_ROW(12);
+    MSL_COMMAND(12, CU10);
+    MSL_ROW(13);
+    if (MSL_ADDITIONAL(13, DI18A0))
+        MSL_COMMAND(13, CU11);
+}
+
+static const msl_clock_cb state_E2_E3_compiled[END_OF_STATUS] = {
+    [TO10] = state_E2_E3_TO10,
+    [TO25] = state_E2_E3_TO25,
+    [TO40] = state_E2_E3_TO40,
+    [TO70] = state_E2_E3_TO70,
+    [TO80] = state_E2_E3_TO80,
+    [TI05] = state_E2_E3_TI05,
+    [TI06] = state_E2_E3_TI06,
+};
+
+static void state_E0_TO10(struct ge *ge)
+{
+    MSL_ROW(0);
+    if (MSL_ADDITIONAL(0, DI17A0))
+        MSL_COMMAND(0, CO12);
+    MSL_ROW(1);
+    if (MSL_ADDITIONAL(1, DI12A0))
+        MSL_COMMAND(1, CO41);
+}
+
+static void state_E0_TO25(struct ge *ge)
+{
+    MSL_ROW(2);
+    if (MSL_ADDITIONAL(2, DI12A0))
+        MSL_COMMAND(2, CO30);
+}
+
+static void state_E0_TO40(struct ge *ge)
+{
+    MSL_ROW(3);
+    if (MSL_ADDITIONAL(3, DI17A0))
+        MSL_COMMAND(3, CO00);
+}
+
+static void state_E0_TO70(struct ge *ge)
+{
+    MSL_ROW(4);
+    if (MSL_ADDITIONAL(4, DI12A0))
+        MSL_COMMAND(4, CI67);
+    MSL_ROW(5);
+    if (MSL_ADDITIONAL(5, DI12A0))
+        MSL_COMMAND(5, CI62);
+}
+
+static void state_E0_TO80(struct ge *ge)
+{
+    MSL_ROW(6);
+    MSL_COMMAND(6, CI39);
+}
+
+static void state_E0_TI05(struct ge *ge)
+{
+    MSL_ROW(7);
+    if (MSL_ADDITIONAL(7, DI17A0))
+        MSL_COMMAND(7, CI05);
+}
+
+static void state_E0_TI06(struct ge *ge)
+{
+    MSL_ROW(8);
+    MSL_COMMAND(8, CU02);
+    MSL_ROW(9);
+    if (MSL_CONDITION(9, state_E0_TI06_CU17))
+        MSL_COMMAND(9, CU17);
+}
+
+static const msl_clock_cb state_E0_compiled[END_OF_STATUS] = {
+    [TO10] = state_E0_TO10,
+    [TO25] = state_E0_TO25,
+    [TO40] = state_E0_TO40,
+    [TO70] = state_E0_TO70,
+    [TO80] = state_E0_TO80,
+    [TI05] = state_E0_TI05,
+    [TI06] = state_E0_TI06,
+};
+
+static void state_E4_TO10(struct ge *ge)
+{
+    MSL_ROW(0);
+    if (MSL_ADDITIONAL(0, DI60A0))
+        MSL_COMMAND(0, CO10);
+    MSL_ROW(1);
+    if (MSL_ADDITIONAL(1, DI60A0))
+        MSL_COMMAND(1, CO41);
+}
+
+static void state_E4_TO25(struct ge *ge)
+{
+    MSL_ROW(2);
+    if (MSL_ADDITIONAL(2, DI12A0))
+        MSL_COMMAND(2, CO30);
+}
+
+static void state_E4_TO40(struct ge *ge)
+{
+    MSL_ROW(3);
+    if (MSL_ADDITIONAL(3, DI60A0))
+        MSL_COMMAND(3, CO00);
+}
+
+static void state_E4_TO70(struct ge *ge)
+{
+    MSL_ROW(4);
+    if (MSL_ADDITIONAL(4, DI12A0))
+        MSL_COMMAND(4, CI67);
+    MSL_ROW(5);
+    if (MSL_ADDITIONAL(5, DI12A0))
+        MSL_COMMAND(5, CI62);
+    MSL_ROW(6);
+    if (MSL_ADDITIONAL(6, DI19A0))
+        MSL_COMMAND(6, CI65);
+    MSL_ROW(7);
+    if (MSL_CONDITION(7, state_E4_TO70_CI60))
+        MSL_COMMAND(7, CI60);
+}
+
+static void state_E4_TI05(struct ge *ge)
+{
+    MSL_ROW(8);
+    MSL_COMMAND(8, CI02);
+}
+
+static void state_E4_TI06(struct ge *ge)
+{
+    MSL_ROW(9);
+    MSL_COMMAND(9, CI06);
+    MSL_ROW(10);
+    if (MSL_ADDITIONAL(10, DI60A0))
+        MSL_COMMAND(10, CU01);
+}
+
+static const msl_clock_cb state_E4_compiled[END_OF_STATUS] = {
+    [TO10] = state_E4_TO10,
+    [TO25] = state_E4_TO25,
+    [TO40] = state_E4_TO40,
+    [TO70] = state_E4_TO70,
+    [TI05] = state_E4_TI05,
+    [TI06] = state_E4_TI06,
+};
+
+static void state_E6_TO10(struct ge *ge)
+{
+    MSL_ROW(0);
+    if (MSL_ADDITIONAL(0, DI60A0))
+        MSL_COMMAND(0, CO10);
+    MSL_ROW(1);
+    if (MSL_ADDITIONAL(1, DI60A0))
+        MSL_COMMAND(1, CO41);
+}
+
+static void state_E6_TO25(struct ge *ge)
+{
+    MSL_ROW(2);
+    if (MSL_ADDITIONAL(2, DI12A0))
+        MSL_COMMAND(2, CO30);
+}
+
+static void state_E6_TO30(struct ge *ge)
+{
+    MSL_ROW(3);
+    MSL_COMMAND(3, CI12);
+}
+
+static void state_E6_TO40(struct ge *ge)
+{
+    MSL_ROW(4);
+    if (MSL_ADDITIONAL(4, DI60A0))
+        MSL_COMMAND(4, CO00);
+}
+
+static void state_E6_TO70(struct ge *ge)
+{
+    MSL_ROW(5);
+    if (MSL_ADDITIONAL(5, DI12A0))
+        MSL_COMMAND(5, CI67);
+    MSL_ROW(6);
+    if (MSL_ADDITIONAL(6, DI12A0))
+        MSL_COMMAND(6, CI62);
+}
+
+static void state_E6_TO80(struct ge *ge)
+{
+    MSL_ROW(7);
+    if (MSL_CONDITION(7, state_E6_TO80_CI38))
+        MSL_COMMAND(7, CI38);
+}
+
+static void state_E6_TI05(struct ge *ge)
+{
+    MSL_ROW(8);
+    MSL_COMMAND(8, CI01);
+    MSL_ROW(9);
+    MSL_COMMAND(9, CI02);
+}
+
+static void state_E6_TI06(struct ge *ge)
+{
+    MSL_ROW(10);
+    if (MSL_ADDITIONAL(10, DI20A0))
+        MSL_COMMAND(10, CU00);
+    MSL_ROW(11);
+    if (MSL_ADDITIONAL(11, EC56A0) && MSL_CONDITION(11, state_E6_TI06_CU03))
+        MSL_COMMAND(11, CU03);
+    MSL_ROW(12);
+    MSL_COMMAND(12, CU11);
+    MSL_ROW(13);
+    if (MSL_CONDITION(13, state_E6_TI06_CU17))
+        MSL_COMMAND(13, CU17);
+}
+
+static const msl_clock_cb state_E6_compiled[END_OF_STATUS] = {
+    [TO10] = state_E6_TO10,
+    [TO25] = state_E6_TO25,
+    [TO30] = state_E6_TO30,
+    [TO40] = state_E6_TO40,
+    [TO70] = state_E6_TO70,
+    [TO80] = state_E6_TO80,
+    [TI05] = state_E6_TI05,
+    [TI06] = state_E6_TI06,
+};
+
+static void state_E5_TO10(struct ge *ge)
+{
+    MSL_ROW(0);
+    if (MSL_ADDITIONAL(0, DI60A0))
+        MSL_COMMAND(0, CO10);
+    MSL_ROW(1);
+    if (MSL_ADDITIONAL(1, DI60A0))
+        MSL_COMMAND(1, CO41);
+}
+
+static void state_E5_TO25(struct ge *ge)
+{
+    MSL_ROW(2);
+    if (MSL_ADDITIONAL(2, DI12A0))
+        MSL_COMMAND(2, CO30);
+}
+
+static void state_E5_TO40(struct ge *ge)
+{
+    MSL_ROW(3);
+    if (MSL_ADDITIONAL(3, DI60A0))
+        MSL_COMMAND(3, CO00);
+}
+
+static void state_E5_TO70(struct ge *ge)
+{
+    MSL_ROW(4);
+    if (MSL_ADDITIONAL(4, DI12A0))
+        MSL_COMMAND(4, CI67);
+    MSL_ROW(5);
+    if (MSL_ADDITIONAL(5, DI12A0))
+        MSL_COMMAND(5, CI62);
+    MSL_ROW(6);
+    if (MSL_ADDITIONAL(6, DI19A0))
+        MSL_COMMAND(6, CI65);
+    MSL_ROW(7);
+    if (MSL_CONDITION(7, not_RO07))
+        MSL_COMMAND(7, CI60);
+}
+
+static void state_E5_TI05(struct ge *ge)
+{
+    MSL_ROW(8);
+    MSL_COMMAND(8, CI02);
+}
+
+static void state_E5_TI06(struct ge *ge)
+{
+    MSL_ROW(9);
+    MSL_COMMAND(9, CI06);
+    MSL_ROW(10);
+    if (MSL_ADDITIONAL(10, DI60A0))
+        MSL_COMMAND(10, CU01);
+}
+
+static const msl_clock_cb state_E5_compiled[END_OF_STATUS] = {
+    [TO10] = state_E5_TO10,
+    [TO25] = state_E5_TO25,
+    [TO40] = state_E5_TO40,
+    [TO70] = state_E5_TO70,
+    [TI05] = state_E5_TI05,
+    [TI06] = state_E5_TI06,
+};
+
+static void state_E7_TO10(struct ge *ge)
+{
+    MSL_ROW(0);
+    if (MSL_ADDITIONAL(0, DI60A0))
+        MSL_COMMAND(0, CO10);
+    MSL_ROW(1);
+    if (MSL_ADDITIONAL(1, DI60A0))
+        MSL_COMMAND(1, CO41);
+}
+
+static void state_E7_TO25(struct ge *ge)
+{
+    MSL_ROW(2);
+    if (MSL_ADDITIONAL(2, DI12A0))
+        MSL_COMMAND(2, CO30);
+}
+
+static void state_E7_TO30(struct ge *ge)
+{
+    MSL_ROW(3);
+    MSL_COMMAND(3, CI12);
+}
+
+static void state_E7_TO40(struct ge *ge)
+{
+    MSL_ROW(4);
+    if (MSL_ADDITIONAL(4, DI60A0))
+        MSL_COMMAND(4, CO00);
+}
+
+static void state_E7_TO70(struct ge *ge)
+{
+    MSL_ROW(5);
+    if (MSL_ADDITIONAL(5, DI12A0))
+        MSL_COMMAND(5, CI67);
+    MSL_ROW(6);
+    MSL_COMMAND(6, CI62);
+}
+
+static void state_E7_TO80(struct ge *ge)
+{
+    MSL_ROW(7);
+    if (MSL_CONDITION(7, state_E7_TO80_CI38))
+        MSL_COMMAND(7, CI38);
+}
+
+static void state_E7_TI05(struct ge *ge)
+{
+    MSL_ROW(8);
+    MSL_COMMAND(8, CI02);
+}
+
+static void state_E7_TI06(struct ge *ge)
+{
+    MSL_ROW(9);
+    if (MSL_ADDITIONAL(9, DI20A0))
+        MSL_COMMAND(9, CU00);
+    MSL_ROW(10);
+    if (MSL_ADDITIONAL(10, EC56A0))
+        MSL_COMMAND(10, CU03);
+    MSL_ROW(11);
+    MSL_COMMAND(11, CU10);
+    MSL_ROW(12);
+    if (MSL_CONDITION(12, state_E7_TI06_CU17))
+        MSL_COMMAND(12, CU17);
+}
+
+static const msl_clock_cb state_E7_compiled[END_OF_STATUS] = {
+    [TO10] = state_E7_TO10,
+    [TO25] = state_E7_TO25,
+    [TO30] = state_E7_TO30,
+    [TO40] = state_E7_TO40,
+    [TO70] = state_E7_TO70,
+    [TO80] = state_E7_TO80,
+    [TI05] = state_E7_TI05,
+    [TI06] = state_E7_TI06,
+};
+
+static void state_64_65_TO10(struct ge *ge)
+{
+    MSL_ROW(0);
+    if (MSL_CONDITION(0, jc_js1_js2_jie))
+        MSL_COMMAND(0, CO10);
+    MSL_ROW(1);
+    if (MSL_CONDITION(1, per_peri))
+        MSL_COMMAND(1, CO18);
+    MSL_ROW(2);
+    if (MSL_ADDITIONAL(2, DE07A0) && MSL_CONDITION(2, per_peri))
+        MSL_COMMAND(2, CO95);
+    MSL_ROW(3);
+    if (MSL_ADDITIONAL(3, DE07A0) && MSL_CONDITION(3, per_peri))
+        MSL_COMMAND(3, CO96);
+    MSL_ROW(4);
+    if (MSL_ADDITIONAL(4, DE07A0) && MSL_CONDITION(4, per_peri))
+        MSL_COMMAND(4, CO97);
+}
+
+static void state_64_65_TO20(struct ge *ge)
+{
+    MSL_ROW(5);
+    if (MSL_CONDITION(5, lon_loll))
+        MSL_COMMAND(5, CI87);
+    MSL_ROW(6);
+    if (MSL_CONDITION(6, ins))
+        MSL_COMMAND(6, CI77);
+}
+
+static void state_64_65_TO25(struct ge *ge)
+{
+    MSL_ROW(7);
+    if (MSL_ADDITIONAL(7, DE08A0) && MSL_CONDITION(7, per_peri_TO25_CO30))
+        MSL_COMMAND(7, CO30);
+}
+
+static void state_64_65_TO30(struct ge *ge)
+{
+    MSL_ROW(8);
+    if (MSL_CONDITION(8, jc_js1_js2_jie))
+        MSL_COMMAND(8, CI12);
+}
+
+static void state_64_65_TO40(struct ge *ge)
+{
+    MSL_ROW(9);
+    if (MSL_CONDITION(9, jc_js1_js2_jie))
+        MSL_COMMAND(9, CO01);
+}
+
+static void state_64_65_TO60(struct ge *ge)
+{
+    MSL_ROW(10);
+    if (MSL_CONDITION(10, jie))
+        MSL_COMMAND(10, CO35);
+}
+
+static void state_64_65_TO65(struct ge *ge)
+{
+    MSL_ROW(11);
+    if (MSL_CONDITION(11, jc_js1_js2_jie_lon_loll_loff_ins_ens_nop))
+        MSL_COMMAND(11, CO49);
+}
+
+static void state_64_65_TO70(struct ge *ge)
+{
+    MSL_ROW(12);
+    if (MSL_CONDITION(12, ens))
+        MSL_COMMAND(12, CI78);
+    MSL_ROW(13);
+    if (MSL_ADDITIONAL(13, DE07A0) && MSL_CONDITION(13, per_peri))
+        MSL_COMMAND(13, CI62);
+    MSL_ROW(14);
+    if (MSL_ADDITIONAL(14, DE07A0) && MSL_CONDITION(14, per_peri))
+        MSL_COMMAND(14, CI67);
+}
+
+static void state_64_65_TO89(struct ge *ge)
+{
+    MSL_ROW(15);
+    if (MSL_CONDITION(15, loff))
+        MSL_COMMAND(15, CI88);
+}
+
+static void state_64_65_TI05(struct ge *ge)
+{
+    MSL_ROW(16);
+    if (MSL_ADDITIONAL(16, DE08A0) && MSL_CONDITION(16, per_peri_TO25_CO30))
+        MSL_COMMAND(16, CI05);
+    MSL_ROW(17);
+    if (MSL_CONDITION(17, jc_js1_js2_jie_condition_verified))
+        MSL_COMMAND(17, CI00);
+}
+
+static void state_64_65_TI06(struct ge *ge)
+{
+    MSL_ROW(18);
+    if (MSL_ADDITIONAL(18, DE00A0) && MSL_CONDITION(18, jc_js1_js2_jie_lon_loll_loff_ins_ens_nop))
+        MSL_COMMAND(18, CU01);
+    MSL_ROW(19);
+    MSL_COMMAND(19, CU10);
+    MSL_ROW(20);
+    if (MSL_CONDITION(20, DE00A0))
+        MSL_COMMAND(20, CU07);
+    MSL_ROW(21);
+    MSL_COMMAND(21, CU12);
+    MSL_ROW(22);
+    if (MSL_CONDITION(22, per_peri))
+        MSL_COMMAND(22, CU15);
+    MSL_ROW(23);
+    if (MSL_CONDITION(23, per_peri))
+        MSL_COMMAND(23, CU03);
+}
+
+static const msl_clock_cb state_64_65_compiled[END_OF_STATUS] = {
+    [TO10] = state_64_65_TO10,
+    [TO20] = state_64_65_TO20,
+    [TO25] = state_64_65_TO25,
+    [TO30] = state_64_65_TO30,
+    [TO40] = state_64_65_TO40,
+    [TO60] = state_64_65_TO60,
+    [TO65] = state_64_65_TO65,
+    [TO70] = state_64_65_TO70,
+    [TO89] = state_64_65_TO89,
+    [TI05] = state_64_65_TI05,
+    [TI06] = state_64_65_TI06,
+};
+
+static void state_00_TO10(struct ge *ge)
+{
+    MSL_ROW(0);
+    if (MSL_CONDITION(0, state_00_TO10_CO10))
+        MSL_COMMAND(0, CO10);
+    MSL_ROW(1);
+    if (MSL_CONDITION(1, state_00_TO10_CO11))
+        MSL_COMMAND(1, CO11);
+    MSL_ROW(2);
+    if (MSL_CONDITION(2, AF50))
+        MSL_COMMAND(2, CO12);
+    MSL_ROW(3);
+    if (MSL_CONDITION(3, AF30))
+        MSL_COMMAND(3, CO13);
+    MSL_ROW(4);
+    if (MSL_CONDITION(4, AF10))
+        MSL_COMMAND(4, CO14);
+}
+
+static void state_00_TO30(struct ge *ge)
+{
+    MSL_ROW(5);
+    if (MSL_CONDITION(5, state_00_TO30_CI15))
+        MSL_COMMAND(5, CI15);
+    MSL_ROW(6);
+    if (MSL_CONDITION(6, AF20))
+        MSL_COMMAND(6, CI17);
+    MSL_ROW(7);
+    if (MSL_CONDITION(7, AF40))
+        MSL_COMMAND(7, CI21);
+    MSL_ROW(8);
+    if (MSL_CONDITION(8, AF40))
+        MSL_COMMAND(8, CI16);
+}
+
+static void state_00_TO50(struct ge *ge)
+{
+    MSL_ROW(9);
+    if (MSL_CONDITION(9, state_00_TO50_CI33))
+        MSL_COMMAND(9, CI33);
+}
+
+static void state_00_TI06(struct ge *ge)
+{
+    MSL_ROW(10);
+    MSL_COMMAND(10, CU07);
+}
+
+static const msl_clock_cb state_00_compiled[END_OF_STATUS] = {
+    [TO10] = state_00_TO10,
+    [TO30] = state_00_TO30,
+    [TO50] = state_00_TO50,
+    [TI06] = state_00_TI06,
+};
+
+static void state_08_TO10(struct ge *ge)
+{
+    MSL_ROW(0);
+    if (MSL_ADDITIONAL(0, EC69A0) && MSL_CONDITION(0, AF41))
+        MSL_COMMAND(0, CO11);
+    MSL_ROW(1);
+    if (MSL_CONDITION(1, AF51))
+        MSL_COMMAND(1, CO11);
+    MSL_ROW(2);
+    MSL_COMMAND(2, CO41);
+}
+
+static void state_08_TO25(struct ge *ge)
+{
+    MSL_ROW(3);
+    if (MSL_CONDITION(3, AF51))
+        MSL_COMMAND(3, CO30);
+    MSL_ROW(4);
+    if (MSL_CONDITION(4, AF41))
+        MSL_COMMAND(4, CO31);
+}
+
+static void state_08_TO30(struct ge *ge)
+{
+    MSL_ROW(5);
+    MSL_COMMAND(5, CI20);
+}
+
+static void state_08_TO40(struct ge *ge)
+{
+    MSL_ROW(6);
+    if (MSL_ADDITIONAL(6, EC69A0) && MSL_CONDITION(6, AF41))
+        MSL_COMMAND(6, CO01);
+    MSL_ROW(7);
+    if (MSL_CONDITION(7, AF51))
+        MSL_COMMAND(7, CO01);
+}
+
+static void state_08_TO50(struct ge *ge)
+{
+    MSL_ROW(8);
+    if (MSL_CONDITION(8, AF52))
+        MSL_COMMAND(8, CO48);
+    MSL_ROW(9);
+    if (MSL_CONDITION(9, AF41))
+        MSL_COMMAND(9, CI33);
+    MSL_ROW(10);
+    if (MSL_CONDITION(10, AF43))
+        MSL_COMMAND(10, CI33);
+}
+
+static void state_08_TO64(struct ge *ge)
+{
+    MSL_ROW(11);
+    if (MSL_CONDITION(11, AF52_not_RO07))
+        MSL_COMMAND(11, CO49);
+}
+
+static void state_08_TO70(struct ge *ge)
+{
+    MSL_ROW(12);
+    if (MSL_ADDITIONAL(12, EC70A0) && MSL_CONDITION(12, AF51))
+        MSL_COMMAND(12, CI62);
+    MSL_ROW(13);
+    if (MSL_CONDITION(13, AF51))
+        MSL_COMMAND(13, CI67);
+}
+
+static void state_08_TI05(struct ge *ge)
+{
+    MSL_ROW(14);
+    if (MSL_CONDITION(14, AF10))
+        MSL_COMMAND(14, CI04);
+    MSL_ROW(15);
+    if (MSL_CONDITION(15, AF50))
+        MSL_COMMAND(15, CI02);
+    MSL_ROW(16);
+    if (MSL_CONDITION(16, AF21))
+        MSL_COMMAND(16, CI05);
+    MSL_ROW(17);
+    if (MSL_CONDITION(17, AF51))
+        MSL_COMMAND(17, CI05);
+    MSL_ROW(18);
+    if (MSL_CONDITION(18, AF31))
+        MSL_COMMAND(18, CI01);
+    MSL_ROW(19);
+    if (MSL_CONDITION(19, AF42))
+        MSL_COMMAND(19, CI00);
+    MSL_ROW(20);
+    if (MSL_CONDITION(20, AF53))
+        MSL_COMMAND(20, CI08);
+}
+
+static void state_08_TI06(struct ge *ge)
+{
+    MSL_ROW(21);
+    if (MSL_CONDITION(21, AF20))
+        MSL_COMMAND(21, CI07);
+    MSL_ROW(22);
+    if (MSL_CONDITION(22, AF30))
+        MSL_COMMAND(22, CI03);
+    MSL_ROW(23);
+    if (MSL_CONDITION(23, AF40))
+        MSL_COMMAND(23, CI06);
+    MSL_ROW(24);
+    if (MSL_CONDITION(24, AF40))
+        MSL_COMMAND(24, CI09);
+    MSL_ROW(25);
+    if (MSL_CONDITION(25, AF52))
+        MSL_COMMAND(25, CI70);
+    MSL_ROW(26);
+    if (MSL_CONDITION(26, AF52))
+        MSL_COMMAND(26, CI71);
+    MSL_ROW(27);
+    if (MSL_CONDITION(27, AF52))
+        MSL_COMMAND(27, CI72);
+    MSL_ROW(28);
+    if (MSL_CONDITION(28, AF52))
+        MSL_COMMAND(28, CI73);
+    MSL_ROW(29);
+    if (MSL_CONDITION(29, AF52))
+        MSL_COMMAND(29, CI74);
+    MSL_ROW(30);
+    if (MSL_CONDITION(30, AF52))
+        MSL_COMMAND(30, CI75);
+    MSL_ROW(31);
+    if (MSL_CONDITION(31, AF52))
+        MSL_COMMAND(31, CI76);
+    MSL_ROW(32);
+    if (MSL_CONDITION(32, AF52_not_RO00))
+        MSL_COMMAND(32, CI80);
+    MSL_ROW(33);
+    if (MSL_CONDITION(33, AF52_not_RO01))
+        MSL_COMMAND(33, CI81);
+    MSL_ROW(34);
+    if (MSL_CONDITION(34, AF52_not_RO02))
+        MSL_COMMAND(34, CI82);
+    MSL_ROW(35);
+    if (MSL_CONDITION(35, AF52_not_RO03))
+        MSL_COMMAND(35, CI83);
+    MSL_ROW(36);
+    if (MSL_CONDITION(36, AF52_not_RO04))
+        MSL_COMMAND(36, CI84);
+    MSL_ROW(37);
+    if (MSL_CONDITION(37, AF52_not_RO05))
+        MSL_COMMAND(37, CI85);
+    MSL_ROW(38);
+    if (MSL_CONDITION(38, AF52_not_RO06))
+        MSL_COMMAND(38, CI86);
+    MSL_ROW(39);
+    MSL_COMMAND(39, CU00);
+    MSL_ROW(40);
+    if (MSL_ADDITIONAL(40, DI57B0))
+        MSL_COMMAND(40, CU01);
+    MSL_ROW(41);
+    MSL_COMMAND(41, CU02);
+    MSL_ROW(42);
+    if (MSL_ADDITIONAL(42, DI57B0))
+        MSL_COMMAND(42, CU03);
+    MSL_ROW(43);
+    if (MSL_ADDITIONAL(43, DI57B0))
+        MSL_COMMAND(43, CU04);
+    MSL_ROW(44);
+    MSL_COMMAND(44, CU05);
+    MSL_ROW(45);
+    MSL_COMMAND(45, CU06);
+    MSL_ROW(46);
+    if (MSL_ADDITIONAL(46, DI57A0))
+        MSL_COMMAND(46, CU07);
+    MSL_ROW(47);
+    if (MSL_CONDITION(47, not_RO00))
+        MSL_COMMAND(47, CU10);
+    MSL_ROW(48);
+    if (MSL_CONDITION(48, not_RO01))
+        MSL_COMMAND(48, CU11);
+    MSL_ROW(49);
+    if (MSL_CONDITION(49, not_RO02))
+        MSL_COMMAND(49, CU12);
+    MSL_ROW(50);
+    if (MSL_CONDITION(50, not_RO03))
+        MSL_COMMAND(50, CU13);
+    MSL_ROW(51);
+    if (MSL_CONDITION(51, not_RO04))
+        MSL_COMMAND(51, CU14);
+    MSL_ROW(52);
+    if (MSL_CONDITION(52, not_RO05))
+        MSL_COMMAND(52, CU15);
+    MSL_ROW(53);
+    if (MSL_CONDITION(53, not_RO06))
+        MSL_COMMAND(53, CU16);
+    MSL_ROW(54);
+    if (MSL_CONDITION(54, not_RO07))
+        MSL_COMMAND(54, CU17);
+}
+
+static const msl_clock_cb state_08_compiled[END_OF_STATUS] = {
+    [TO10] = state_08_TO10,
+    [TO25] = state_08_TO25,
+    [TO30] = state_08_TO30,
+    [TO40] = state_08_TO40,
+    [TO50] = state_08_TO50,
+    [TO64] = state_08_TO64,
+    [TO70] = state_08_TO70,
+    [TI05] = state_08_TI05,
+    [TI06] = state_08_TI06,
+};
+
+static void state_c8_TO10(struct ge *ge)
+{
+    MSL_ROW(0);
+    if (MSL_ADDITIONAL(0, DI97A0))
+        MSL_COMMAND(0, CO12);
+    MSL_ROW(1);
+    if (MSL_ADDITIONAL(1, DI97A0))
+        MSL_COMMAND(1, CO41);
+}
+
+static void state_c8_TO25(struct ge *ge)
+{
+    MSL_ROW(2);
+    if (MSL_ADDITIONAL(2, ED70A0) && MSL_CONDITION(2, not_AINI))
+        MSL_COMMAND(2, CO30);
+}
+
+static void state_c8_TO40(struct ge *ge)
+{
+    MSL_ROW(3);
+    if (MSL_ADDITIONAL(3, DI97A0))
+        MSL_COMMAND(3, CO02);
+}
+
+static void state_c8_TO70(struct ge *ge)
+{
+    MSL_ROW(4);
+    if (MSL_ADDITIONAL(4, DI25A0))
+        MSL_COMMAND(4, CI62);
+    MSL_ROW(5);
+    if (MSL_ADDITIONAL(5, DI25A0))
+        MSL_COMMAND(5, CI67);
+}
+
+static void state_c8_TI06(struct ge *ge)
+{
+    MSL_ROW(6);
+    MSL_COMMAND(6, CI06);
+    MSL_ROW(7);
+    if (MSL_ADDITIONAL(7, DI25A0))
+        MSL_COMMAND(7, CI75);
+    MSL_ROW(8);
+    if (MSL_ADDITIONAL(8, DI25A0))
+        MSL_COMMAND(8, CI84);
+    MSL_ROW(9);
+    if (MSL_CONDITION(9, state_c8_TI06_CI85))
+        MSL_COMMAND(9, CI85);
+    MSL_ROW(10);
+    MSL_COMMAND(10, CU04);
+}
+
+static const msl_clock_cb state_c8_compiled[END_OF_STATUS] = {
+    [TO10] = state_c8_TO10,
+    [TO25] = state_c8_TO25,
+    [TO40] = state_c8_TO40,
+    [TO70] = state_c8_TO70,
+    [TI06] = state_c8_TI06,
+};
+
+static void state_d8_TO10(struct ge *ge)
+{
+    MSL_ROW(0);
+    MSL_COMMAND(0, CO10);
+    MSL_ROW(1);
+    if (MSL_ADDITIONAL(1, DI21A0))
+        MSL_COMMAND(1, CO40);
+    MSL_ROW(2);
+    if (MSL_ADDITIONAL(2, DI21A0))
+        MSL_COMMAND(2, CO41);
+}
+
+static void state_d8_TO19(struct ge *ge)
+{
+    MSL_ROW(3);
+    if (MSL_CONDITION(3, state_d8_TO19_CE02))
+        MSL_COMMAND(3, CE02);
+}
+
+static void state_d8_TO30(struct ge *ge)
+{
+    MSL_ROW(4);
+    if (MSL_ADDITIONAL(4, DI21A0))
+        MSL_COMMAND(4, CI15);
+}
+
+static void state_d8_TO40(struct ge *ge)
+{
+    MSL_ROW(5);
+    if (MSL_CONDITION(5, state_d8_TO40_CO00))
+        MSL_COMMAND(5, CO00);
+}
+
+static void state_d8_TO50(struct ge *ge)
+{
+    MSL_ROW(6);
+    if (MSL_ADDITIONAL(6, DI21A0))
+        MSL_COMMAND(6, CI33);
+    MSL_ROW(7);
+    MSL_COMMAND(7, CE01);
+}
+
+static void state_d8_TI06(struct ge *ge)
+{
+    MSL_ROW(8);
+    if (MSL_ADDITIONAL(8, DI93A0))
+        MSL_COMMAND(8, CU00);
+}
+
+static const msl_clock_cb state_d8_compiled[END_OF_STATUS] = {
+    [TO10] = state_d8_TO10,
+    [TO19] = state_d8_TO19,
+    [TO30] = state_d8_TO30,
+    [TO40] = state_d8_TO40,
+    [TO50] = state_d8_TO50,
+    [TI06] = state_d8_TI06,
+};
+
+static void state_d9_TO10(struct ge *ge)
+{
+    MSL_ROW(0);
+    MSL_COMMAND(0, CO10);
+    MSL_ROW(1);
+    if (MSL_ADDITIONAL(1, DI21A0))
+        MSL_COMMAND(1, CO40);
+    MSL_ROW(2);
+    if (MSL_ADDITIONAL(2, DI21A0))
+        MSL_COMMAND(2, CO41);
+}
+
+static void state_d9_TO30(struct ge *ge)
+{
+    MSL_ROW(3);
+    if (MSL_ADDITIONAL(3, DI21A0))
+        MSL_COMMAND(3, CI15);
+}
+
+static void state_d9_TO40(struct ge *ge)
+{
+    MSL_ROW(4);
+    if (MSL_CONDITION(4, state_d9_TO40_CO00))
+        MSL_COMMAND(4, CO00);
+}
+
+static void state_d9_TO50(struct ge *ge)
+{
+    MSL_ROW(5);
+    if (MSL_ADDITIONAL(5, DI21A0))
+        MSL_COMMAND(5, CI33);
+}
+
+static void state_d9_TI06(struct ge *ge)
+{
+    MSL_ROW(6);
+    if (MSL_ADDITIONAL(6, DI93A0))
+        MSL_COMMAND(6, CU00);
+    MSL_ROW(7);
+    if (MSL_ADDITIONAL(7, DI94A0))
+        MSL_COMMAND(7, CU01);
+    MSL_ROW(8);
+    MSL_COMMAND(8, CU10);
+}
+
+static const msl_clock_cb state_d9_compiled[END_OF_STATUS] = {
+    [TO10] = state_d9_TO10,
+    [TO30] = state_d9_TO30,
+    [TO40] = state_d9_TO40,
+    [TO50] = state_d9_TO50,
+    [TI06] = state_d9_TI06,
+};
+
+static void state_da_TO10(struct ge *ge)
+{
+    MSL_ROW(0);
+    MSL_COMMAND(0, CO10);
+    MSL_ROW(1);
+    if (MSL_ADDITIONAL(1, DI21A0))
+        MSL_COMMAND(1, CO40);
+    MSL_ROW(2);
+    if (MSL_ADDITIONAL(2, DI21A0))
+        MSL_COMMAND(2, CO41);
+}
+
+static void state_da_TO30(struct ge *ge)
+{
+    MSL_ROW(3);
+    if (MSL_ADDITIONAL(3, DI21A0))
+        MSL_COMMAND(3, CI15);
+}
+
+static void state_da_TO40(struct ge *ge)
+{
+    MSL_ROW(4);
+    if (MSL_CONDITION(4, state_d9_TO40_CO00))
+        MSL_COMMAND(4, CO00);
+}
+
+static void state_da_TO50(struct ge *ge)
+{
+    MSL_ROW(5);
+    if (MSL_ADDITIONAL(5, DI21A0))
+        MSL_COMMAND(5, CI33);
+}
+
+static void state_da_TI06(struct ge *ge)
+{
+    MSL_ROW(6);
+    if (MSL_ADDITIONAL(6, DI93A0))
+        MSL_COMMAND(6, CU00);
+}
+
+static const msl_clock_cb state_da_compiled[END_OF_STATUS] = {
+    [TO10] = state_da_TO10,
+    [TO30] = state_da_TO30,
+    [TO40] = state_da_TO40,
+    [TO50] = state_da_TO50,
+    [TI06] = state_da_TI06,
+};
+
+static void state_db_TO10(struct ge *ge)
+{
+    MSL_ROW(0);
+    MSL_COMMAND(0, CO10);
+    MSL_ROW(1);
+    if (MSL_ADDITIONAL(1, DI21A0))
+        MSL_COMMAND(1, CO40);
+    MSL_ROW(2);
+    if (MSL_ADDITIONAL(2, DI21A0))
+        MSL_COMMAND(2, CO41);
+}
+
+static void state_db_TO30(struct ge *ge)
+{
+    MSL_ROW(3);
+    if (MSL_ADDITIONAL(3, DI21A0))
+        MSL_COMMAND(3, CI15);
+}
+
+static void state_db_TO40(struct ge *ge)
+{
+    MSL_ROW(4);
+    if (MSL_CONDITION(4, state_d9_TO40_CO00))
+        MSL_COMMAND(4, CO00);
+}
+
+static void state_db_TO50(struct ge *ge)
+{
+    MSL_ROW(5);
+    if (MSL_ADDITIONAL(5, DI21A0))
+        MSL_COMMAND(5, CI33);
+}
+
+static void state_db_TI06(struct ge *ge)
+{
+    MSL_ROW(6);
+    if (MSL_ADDITIONAL(6, DI91A0))
+        MSL_COMMAND(6, CI74);
+    MSL_ROW(7);
+    if (MSL_ADDITIONAL(7, DI93A0))
+        MSL_COMMAND(7, CU00);
+    MSL_ROW(8);
+    MSL_COMMAND(8, CU10);
+    MSL_ROW(9);
+    if (MSL_ADDITIONAL(9, DI94A0))
+        MSL_COMMAND(9, CU01);
+    MSL_ROW(10);
+    if (MSL_ADDITIONAL(10, DI95A0))
+        MSL_COMMAND(10, CU11);
+    MSL_ROW(11);
+    MSL_COMMAND(11, CU12);
+    MSL_ROW(12);
+    if (MSL_CONDITION(12, state_d8_TO19_CE02))
+        MSL_COMMAND(12, CU02);
+}
+
+static const msl_clock_cb state_db_compiled[END_OF_STATUS] = {
+    [TO10] = state_db_TO10,
+    [TO30] = state_db_TO30,
+    [TO40] = state_db_TO40,
+    [TO50] = state_db_TO50,
+    [TI06] = state_db_TI06,
+};
+
+static void state_dc_TO10(struct ge *ge)
+{
+    MSL_ROW(0);
+    MSL_COMMAND(0, CO13);
+}
+
+static void state_dc_TO30(struct ge *ge)
+{
+    MSL_ROW(1);
+    MSL_COMMAND(1, CI19);
+    MSL_ROW(2);
+    MSL_COMMAND(2, CO90);
+}
+
+static void state_dc_TO40(struct ge *ge)
+{
+    MSL_ROW(3);
+    MSL_COMMAND(3, CO01);
+}
+
+static void state_dc_TO50(struct ge *ge)
+{
+    MSL_ROW(4);
+    if (MSL_ADDITIONAL(4, DI22A0))
+        MSL_COMMAND(4, CI32);
+}
+
+static void state_dc_TI06(struct ge *ge)
+{
+    MSL_ROW(5);
+    if (MSL_CONDITION(5, state_dc_TI06_CI70))
+        MSL_COMMAND(5, CI70);
+    MSL_ROW(6);
+    if (MSL_ADDITIONAL(6, DI22A0))
+        MSL_COMMAND(6, CU14);
+    MSL_ROW(7);
+    if (MSL_CONDITION(7, state_dc_TI06_CU20))
+        MSL_COMMAND(7, CU20);
+}
+
+static const msl_clock_cb state_dc_compiled[END_OF_STATUS] = {
+    [TO10] = state_dc_TO10,
+    [TO30] = state_dc_TO30,
+    [TO40] = state_dc_TO40,
+    [TO50] = state_dc_TO50,
+    [TI06] = state_dc_TI06,
+};
+
+static void state_cc_TO10(struct ge *ge)
+{
+    MSL_ROW(0);
+    if (MSL_ADDITIONAL(0, DI97A0))
+        MSL_COMMAND(0, CO12);
+    MSL_ROW(1);
+    if (MSL_ADDITIONAL(1, DI97A0))
+        MSL_COMMAND(1, CO41);
+}
+
+static void state_cc_TO25(struct ge *ge)
+{
+    MSL_ROW(2);
+    if (MSL_ADDITIONAL(2, ED70A0) && MSL_CONDITION(2, not_AINI))
+        MSL_COMMAND(2, CO30);
+}
+
+static void state_cc_TO30(struct ge *ge)
+{
+    MSL_ROW(3);
+    if (MSL_ADDITIONAL(3, DI24A0))
+        MSL_COMMAND(3, CI19);
+    MSL_ROW(4);
+    MSL_COMMAND(4, CO96);
+}
+
+static void state_cc_TO40(struct ge *ge)
+{
+    MSL_ROW(5);
+    if (MSL_CONDITION(5, DI97A0))
+        MSL_COMMAND(5, CO02);
+}
+
+static void state_cc_TO50(struct ge *ge)
+{
+    MSL_ROW(6);
+    if (MSL_CONDITION(6, AINI))
+        MSL_COMMAND(6, CI32);
+    MSL_ROW(7);
+    MSL_COMMAND(7, CE01);
+    MSL_ROW(8);
+    if (MSL_CONDITION(8, state_cc_TO50_CE00))
+        MSL_COMMAND(8, CE00);
+}
+
+static void state_cc_TI06(struct ge *ge)
+{
+    MSL_ROW(9);
+    if (MSL_CONDITION(9, state_cc_TI06_CI75))
+        MSL_COMMAND(9, CI75);
+    MSL_ROW(10);
+    if (MSL_CONDITION(10, state_cc_TI06_CU13))
+        MSL_COMMAND(10, CU13);
+    MSL_ROW(11);
+    MSL_COMMAND(11, CU12);
+    MSL_ROW(12);
+    if (MSL_CONDITION(12, state_cc_TI06_CU05))
+        MSL_COMMAND(12, CU05);
+    MSL_ROW(13);
+    if (MSL_CONDITION(13, state_cc_TI06_CU04))
+        MSL_COMMAND(13, CU04);
+    MSL_ROW(14);
+    if (MSL_CONDITION(14, state_cc_TI06_CU01))
+        MSL_COMMAND(14, CU01);
+}
+
+static const msl_clock_cb state_cc_compiled[END_OF_STATUS] = {
+    [TO10] = state_cc_TO10,
+    [TO25] = state_cc_TO25,
+    [TO30] = state_cc_TO30,
+    [TO40] = state_cc_TO40,
+    [TO50] = state_cc_TO50,
+    [TI06] = state_cc_TI06,
+};
+
+static void state_ca_TO19(struct ge *ge)
+{
+    MSL_ROW(0);
+    if (MSL_CONDITION(0, L207))
+        MSL_COMMAND(0, CE08);
+}
+
+static void state_ca_TO65(struct ge *ge)
+{
+    MSL_ROW(1);
+    MSL_COMMAND(1, CE03);
+}
+
+static void state_ca_TO80(struct ge *ge)
+{
+    MSL_ROW(2);
+    if (MSL_CONDITION(2, state_ca_TO80_CE18))
+        MSL_COMMAND(2, CE18);
+}
+
+static void state_ca_TI06(struct ge *ge)
+{
+    MSL_ROW(3);
+    if (MSL_CONDITION(3, not_L207))
+        MSL_COMMAND(3, CU16);
+    MSL_ROW(4);
+    MSL_COMMAND(4, CU05);
+    MSL_ROW(5);
+    if (MSL_CONDITION(5, L207))
+        MSL_COMMAND(5, CU13);
+    MSL_ROW(6);
+    if (MSL_CONDITION(6, not_L207))
+        MSL_COMMAND(6, CU11);
+}
+
+static void state_ca_TI10(struct ge *ge)
+{
+    MSL_ROW(7);
+    if (MSL_CONDITION(7, L207))
+        MSL_COMMAND(7, CE10);
+}
+
+static const msl_clock_cb state_ca_compiled[END_OF_STATUS] = {
+    [TO19] = state_ca_TO19,
+    [TO65] = state_ca_TO65,
+    [TO80] = state_ca_TO80,
+    [TI06] = state_ca_TI06,
+    [TI10] = state_ca_TI10,
+};
+
+static void state_a8_TO10(struct ge *ge)
+{
+    MSL_ROW(0);
+    if (MSL_ADDITIONAL(0, DI97A0))
+        MSL_COMMAND(0, CO12);
+    MSL_ROW(1);
+    if (MSL_ADDITIONAL(1, DI97A0))
+        MSL_COMMAND(1, CO41);
+}
+
+static void state_a8_TO25(struct ge *ge)
+{
+    MSL_ROW(2);
+    if (MSL_ADDITIONAL(2, ED70A0) && MSL_CONDITION(2, not_AINI))
+        MSL_COMMAND(2, CO30);
+}
+
+static void state_a8_TO30(struct ge *ge)
+{
+    MSL_ROW(3);
+    if (MSL_ADDITIONAL(3, DI29A0))
+        MSL_COMMAND(3, CI19);
+}
+
+static void state_a8_TO40(struct ge *ge)
+{
+    MSL_ROW(4);
+    if (MSL_ADDITIONAL(4, DI97A0))
+        MSL_COMMAND(4, CO02);
+}
+
+static void state_a8_TO70(struct ge *ge)
+{
+    MSL_ROW(5);
+    if (MSL_ADDITIONAL(5, DI86A0))
+        MSL_COMMAND(5, CI60);
+    MSL_ROW(6);
+    if (MSL_ADDITIONAL(6, DI86A0))
+        MSL_COMMAND(6, CI65);
+}
+
+static void state_a8_TI05(struct ge *ge)
+{
+    MSL_ROW(7);
+    if (MSL_ADDITIONAL(7, DI87A0))
+        MSL_COMMAND(7, CI05);
+}
+
+static void state_a8_TI06(struct ge *ge)
+{
+    MSL_ROW(8);
+    if (MSL_ADDITIONAL(8, DI93A0))
+        MSL_COMMAND(8, CU00);
+}
+
+static const msl_clock_cb state_a8_compiled[END_OF_STATUS] = {
+    [TO10] = state_a8_TO10,
+    [TO25] = state_a8_TO25,
+    [TO30] = state_a8_TO30,
+    [TO40] = state_a8_TO40,
+    [TO70] = state_a8_TO70,
+    [TI05] = state_a8_TI05,
+    [TI06] = state_a8_TI06,
+};
+
+static void state_a9_TO10(struct ge *ge)
+{
+    MSL_ROW(0);
+    if (MSL_ADDITIONAL(0, DI97A0))
+        MSL_COMMAND(0, CO12);
+    MSL_ROW(1);
+    if (MSL_ADDITIONAL(1, DI97A0))
+        MSL_COMMAND(1, CO41);
+}
+
+static void state_a9_TO25(struct ge *ge)
+{
+    MSL_ROW(2);
+    if (MSL_ADDITIONAL(2, ED70A0) && MSL_CONDITION(2, not_AINI))
+        MSL_COMMAND(2, CO30);
+}
+
+static void state_a9_TO30(struct ge *ge)
+{
+    MSL_ROW(3);
+    if (MSL_ADDITIONAL(3, DI29A0))
+        MSL_COMMAND(3, CI19);
+    MSL_ROW(4);
+    if (MSL_ADDITIONAL(4, DI84A0))
+        MSL_COMMAND(4, CI15);
+    MSL_ROW(5);
+    if (MSL_CONDITION(5, AINI))
+        MSL_COMMAND(5, CO97);
+}
+
+static void state_a9_TO40(struct ge *ge)
+{
+    MSL_ROW(6);
+    if (MSL_ADDITIONAL(6, DI97A0))
+        MSL_COMMAND(6, CO02);
+}
+
+static void state_a9_TO50(struct ge *ge)
+{
+    MSL_ROW(7);
+    if (MSL_ADDITIONAL(7, ED75A0) && MSL_CONDITION(7, AINI))
+        MSL_COMMAND(7, CI32);
+}
+
+static void state_a9_TO70(struct ge *ge)
+{
+    MSL_ROW(8);
+    if (MSL_ADDITIONAL(8, ED79A0))
+        MSL_COMMAND(8, CI62);
+    MSL_ROW(9);
+    if (MSL_ADDITIONAL(9, ED79A0))
+        MSL_COMMAND(9, CI67);
+}
+
+static void state_a9_TI05(struct ge *ge)
+{
+    MSL_ROW(10);
+    if (MSL_ADDITIONAL(10, DI87A0))
+        MSL_COMMAND(10, CI05);
+}
+
+static void state_a9_TI06(struct ge *ge)
+{
+    MSL_ROW(11);
+    if (MSL_CONDITION(11, PC031))
+        MSL_COMMAND(11, CI07);
+    MSL_ROW(12);
+    if (MSL_ADDITIONAL(12, DI93A0))
+        MSL_COMMAND(12, CU00);
+    MSL_ROW(13);
+    MSL_COMMAND(13, CU10);
+    MSL_ROW(14);
+    if (MSL_CONDITION(14, DI94A0))
+        MSL_COMMAND(14, CU01);
+}
+
+static const msl_clock_cb state_a9_compiled[END_OF_STATUS] = {
+    [TO10] = state_a9_TO10,
+    [TO25] = state_a9_TO25,
+    [TO30] = state_a9_TO30,
+    [TO40] = state_a9_TO40,
+    [TO50] = state_a9_TO50,
+    [TO70] = state_a9_TO70,
+    [TI05] = state_a9_TI05,
+    [TI06] = state_a9_TI06,
+};
+
+static void state_aa_TO10(struct ge *ge)
+{
+    MSL_ROW(0);
+    if (MSL_ADDITIONAL(0, DI97A0))
+        MSL_COMMAND(0, CO12);
+    MSL_ROW(1);
+    if (MSL_ADDITIONAL(1, DI97A0))
+        MSL_COMMAND(1, CO41);
+}
+
+static void state_aa_TO25(struct ge *ge)
+{
+    MSL_ROW(2);
+    if (MSL_ADDITIONAL(2, ED70A0) && MSL_CONDITION(2, not_AINI))
+        MSL_COMMAND(2, CO30);
+}
+
+static void state_aa_TO30(struct ge *ge)
+{
+    MSL_ROW(3);
+    if (MSL_ADDITIONAL(3, DI29A0))
+        MSL_COMMAND(3, CI19);
+}
+
+static void state_aa_TO40(struct ge *ge)
+{
+    MSL_ROW(4);
+    if (MSL_ADDITIONAL(4, DI97A0))
+        MSL_COMMAND(4, CO02);
+}
+
+static void state_aa_TO70(struct ge *ge)
+{
+    MSL_ROW(5);
+    if (MSL_ADDITIONAL(5, DI86A0))
+        MSL_COMMAND(5, CI60);
+    MSL_ROW(6);
+    if (MSL_ADDITIONAL(6, DI86A0))
+        MSL_COMMAND(6, CI65);
+}
+
+static void state_aa_TI05(struct ge *ge)
+{
+    MSL_ROW(7);
+    MSL_COMMAND(7, CI01);
+}
+
+static void state_aa_TI06(struct ge *ge)
+{
+    MSL_ROW(8);
+    if (MSL_ADDITIONAL(8, DI93A0))
+        MSL_COMMAND(8, CU00);
+}
+
+static const msl_clock_cb state_aa_compiled[END_OF_STATUS] = {
+    [TO10] = state_aa_TO10,
+    [TO25] = state_aa_TO25,
+    [TO30] = state_aa_TO30,
+    [TO40] = state_aa_TO40,
+    [TO70] = state_aa_TO70,
+    [TI05] = state_aa_TI05,
+    [TI06] = state_aa_TI06,
+};
+
+static void state_ab_TO10(struct ge *ge)
+{
+    MSL_ROW(0);
+    if (MSL_ADDITIONAL(0, DI97A0))
+        MSL_COMMAND(0, CO12);
+    MSL_ROW(1);
+    if (MSL_ADDITIONAL(1, DI97A0))
+        MSL_COMMAND(1, CO41);
+}
+
+static void state_ab_TO19(struct ge *ge)
+{
+    MSL_ROW(2);
+    MSL_COMMAND(2, CE07);
+    MSL_ROW(3);
+    MSL_COMMAND(3, CE08);
+}
+
+static void state_ab_TO25(struct ge *ge)
+{
+    MSL_ROW(4);
+    if (MSL_ADDITIONAL(4, ED70A0) && MSL_CONDITION(4, not_AINI))
+        MSL_COMMAND(4, CO30);
+}
+
+static void state_ab_TO30(struct ge *ge)
+{
+    MSL_ROW(5);
+    if (MSL_ADDITIONAL(5, DI29A0))
+        MSL_COMMAND(5, CI19);
+    MSL_ROW(6);
+    MSL_COMMAND(6, CI11);
+}
+
+static void state_ab_TO40(struct ge *ge)
+{
+    MSL_ROW(7);
+    if (MSL_ADDITIONAL(7, DI97A0))
+        MSL_COMMAND(7, CO02);
+}
+
+static void state_ab_TO70(struct ge *ge)
+{
+    MSL_ROW(8);
+    if (MSL_ADDITIONAL(8, ED79A0) && MSL_CONDITION(8, state_ab_TO70_CI62))
+        MSL_COMMAND(8, CI62);
+    MSL_ROW(9);
+    if (MSL_ADDITIONAL(9, ED79A0) && MSL_CONDITION(9, state_ab_TO70_CI62))
+        MSL_COMMAND(9, CI67);
+}
+
+static void state_ab_TO80(struct ge *ge)
+{
+    MSL_ROW(10);
+    if (MSL_CONDITION(10, state_ab_TO80_CE18))
+        MSL_COMMAND(10, CE18);
+}
+
+static void state_ab_TI05(struct ge *ge)
+{
+    MSL_ROW(11);
+    MSL_COMMAND(11, CI01);
+    MSL_ROW(12);
+    if (MSL_CONDITION(12, state_ab_TI05_CI04))
+        MSL_COMMAND(12, CI04);
+    MSL_ROW(13);
+    if (MSL_CONDITION(13, state_ab_TI05_CI03))
+        MSL_COMMAND(13, CI03);
+}
+
+static void state_ab_TI06(struct ge *ge)
+{
+    MSL_ROW(14);
+    if (MSL_ADDITIONAL(14, DI93A0))
+        MSL_COMMAND(14, CU00);
+    MSL_ROW(15);
+    MSL_COMMAND(15, CU10);
+    MSL_ROW(16);
+    if (MSL_ADDITIONAL(16, DI94A0))
+        MSL_COMMAND(16, CU01);
+    MSL_ROW(17);
+    if (MSL_ADDITIONAL(17, DI95A0))
+        MSL_COMMAND(17, CU11);
+    MSL_ROW(18);
+    if (MSL_ADDITIONAL(18, DI85A0))
+        MSL_COMMAND(18, CU04);
+}
+
+static void state_ab_TI10(struct ge *ge)
+{
+    MSL_ROW(19);
+    MSL_COMMAND(19, CE10);
+}
+
+static const msl_clock_cb state_ab_compiled[END_OF_STATUS] = {
+    [TO10] = state_ab_TO10,
+    [TO19] = state_ab_TO19,
+    [TO25] = state_ab_TO25,
+    [TO30] = state_ab_TO30,
+    [TO40] = state_ab_TO40,
+    [TO70] = state_ab_TO70,
+    [TO80] = state_ab_TO80,
+    [TI05] = state_ab_TI05,
+    [TI06] = state_ab_TI06,
+    [TI10] = state_ab_TI10,
+};
+
+static void state_b8_TI06(struct ge *ge)
+{
+    MSL_ROW(0);
+    if (MSL_CONDITION(0, state_b8_TI06_CI72))
+        MSL_COMMAND(0, CI72);
+    MSL_ROW(1);
+    MSL_COMMAND(1, CI70);
+    MSL_ROW(2);
+    if (MSL_CONDITION(2, DU97_or_DU98))
+        MSL_COMMAND(2, CU01);
+    MSL_ROW(3);
+    if (MSL_CONDITION(3, DU97))
+        MSL_COMMAND(3, CU13);
+    MSL_ROW(4);
+    if (MSL_CONDITION(4, DU97_or_DU98))
+        MSL_COMMAND(4, CU14);
+    MSL_ROW(5);
+    if (MSL_CONDITION(5, DU97_or_DU98))
+        MSL_COMMAND(5, CU06);
+}
+
+static void state_b8_TI10(struct ge *ge)
+{
+    MSL_ROW(6);
+    if (MSL_CONDITION(6, state_b8_TI10_CE09))
+        MSL_COMMAND(6, CE09);
+}
+
+static const msl_clock_cb state_b8_compiled[END_OF_STATUS] = {
+    [TI06] = state_b8_TI06,
+    [TI10] = state_b8_TI10,
+};
+
+static void state_b1_TO10(struct ge *ge)
+{
+    MSL_ROW(0);
+    MSL_COMMAND(0, CO11);
+    MSL_ROW(1);
+    MSL_COMMAND(1, CO41);
+    MSL_ROW(2);
+    if (MSL_CONDITION(2, L205))
+        MSL_COMMAND(2, CO40);
+}
+
+static void state_b1_TO25(struct ge *ge)
+{
+    MSL_ROW(3);
+    if (MSL_CONDITION(3, FA01))
+        MSL_COMMAND(3, CO31);
+}
+
+static void state_b1_TO30(struct ge *ge)
+{
+    MSL_ROW(4);
+    if (MSL_CONDITION(4, not_FA01))
+        MSL_COMMAND(4, CI15);
+    MSL_ROW(5);
+    if (MSL_CONDITION(5, FA01))
+        MSL_COMMAND(5, CI12);
+    MSL_ROW(6);
+    MSL_COMMAND(6, CI41);
+}
+
+static void state_b1_TO40(struct ge *ge)
+{
+    MSL_ROW(7);
+    if (MSL_CONDITION(7, FA01))
+        MSL_COMMAND(7, CO01);
+}
+
+static void state_b1_TO50(struct ge *ge)
+{
+    MSL_ROW(8);
+    if (MSL_CONDITION(8, FA01))
+        MSL_COMMAND(8, CI33);
+}
+
+static void state_b1_TO80(struct ge *ge)
+{
+    MSL_ROW(9);
+    MSL_COMMAND(9, CE18);
+}
+
+static void state_b1_TI05(struct ge *ge)
+{
+    MSL_ROW(10);
+    if (MSL_CONDITION(10, not_FA01))
+        MSL_COMMAND(10, CI05);
+}
+
+static void state_b1_TI06(struct ge *ge)
+{
+    MSL_ROW(11);
+    MSL_COMMAND(11, CI71);
+    MSL_ROW(12);
+    if (MSL_CONDITION(12, FA01))
+        MSL_COMMAND(12, CI81);
+    MSL_ROW(13);
+    MSL_COMMAND(13, CU03);
+    MSL_ROW(14);
+    MSL_COMMAND(14, CU10);
+}
+
+static const msl_clock_cb state_b1_compiled[END_OF_STATUS] = {
+    [TO10] = state_b1_TO10,
+    [TO25] = state_b1_TO25,
+    [TO30] = state_b1_TO30,
+    [TO40] = state_b1_TO40,
+    [TO50] = state_b1_TO50,
+    [TO80] = state_b1_TO80,
+    [TI05] = state_b1_TI05,
+    [TI06] = state_b1_TI06,
+};
+
+static void state_b9_TO10(struct ge *ge)
+{
+    MSL_ROW(0);
+    MSL_COMMAND(0, CO11);
+    MSL_ROW(1);
+    MSL_COMMAND(1, CO41);
+    MSL_ROW(2);
+    if (MSL_CONDITION(2, L205))
+        MSL_COMMAND(2, CO40);
+}
+
+static void state_b9_TO25(struct ge *ge)
+{
+    MSL_ROW(3);
+    if (MSL_CONDITION(3, state_b9_TO25_CO31))
+        MSL_COMMAND(3, CO31);
+}
+
+static void state_b9_TO30(struct ge *ge)
+{
+    MSL_ROW(4);
+    if (MSL_CONDITION(4, L204))
+        MSL_COMMAND(4, CI15);
+    MSL_ROW(5);
+    if (MSL_CONDITION(5, L204))
+        MSL_COMMAND(5, CI41);
+    MSL_ROW(6);
+    if (MSL_CONDITION(6, L204))
+        MSL_COMMAND(6, CI40);
+    MSL_ROW(7);
+    if (MSL_CONDITION(7, state_b9_TO30_CI12))
+        MSL_COMMAND(7, CI12);
+}
+
+static void state_b9_TO40(struct ge *ge)
+{
+    MSL_ROW(8);
+    if (MSL_CONDITION(8, state_b9_TO40_CO01))
+        MSL_COMMAND(8, CO01);
+}
+
+static void state_b9_TO50(struct ge *ge)
+{
+    MSL_ROW(9);
+    if (MSL_CONDITION(9, not_L206))
+        MSL_COMMAND(9, CI34);
+}
+
+static void state_b9_TO65(struct ge *ge)
+{
+    MSL_ROW(10);
+    if (MSL_CONDITION(10, not_L206))
+        MSL_COMMAND(10, CE11);
+}
+
+static void state_b9_TO70(struct ge *ge)
+{
+    MSL_ROW(11);
+    if (MSL_CONDITION(11, state_b9_TO70_CI67))
+        MSL_COMMAND(11, CI67);
+    MSL_ROW(12);
+    if (MSL_CONDITION(12, state_b9_TO70_CI66))
+        MSL_COMMAND(12, CI66);
+}
+
+static void state_b9_TO80(struct ge *ge)
+{
+    MSL_ROW(13);
+    if (MSL_CONDITION(13, L204))
+        MSL_COMMAND(13, CE18);
+    MSL_ROW(14);
+    if (MSL_CONDITION(14, state_b9_TO80_CE05))
+        MSL_COMMAND(14, CE05);
+}
+
+static void state_b9_TI05(struct ge *ge)
+{
+    MSL_ROW(15);
+    if (MSL_CONDITION(15, L204))
+        MSL_COMMAND(15, CI05);
+    MSL_ROW(16);
+    if (MSL_CONDITION(16, not_L206))
+        MSL_COMMAND(16, CI02);
+}
+
+static void state_b9_TI06(struct ge *ge)
+{
+    MSL_ROW(17);
+    if (MSL_CONDITION(17, state_b9_TI06_CU13))
+        MSL_COMMAND(17, CU13);
+}
+
+static void state_b9_TI10(struct ge *ge)
+{
+    MSL_ROW(18);
+    if (MSL_CONDITION(18, state_b9_TI10_CE09))
+        MSL_COMMAND(18, CE09);
+}
+
+static const msl_clock_cb state_b9_compiled[END_OF_STATUS] = {
+    [TO10] = state_b9_TO10,
+    [TO25] = state_b9_TO25,
+    [TO30] = state_b9_TO30,
+    [TO40] = state_b9_TO40,
+    [TO50] = state_b9_TO50,
+    [TO65] = state_b9_TO65,
+    [TO70] = state_b9_TO70,
+    [TO80] = state_b9_TO80,
+    [TI05] = state_b9_TI05,
+    [TI06] = state_b9_TI06,
+    [TI10] = state_b9_TI10,
+};
+
+static void state_ea_TO10(struct ge *ge)
+{
+    MSL_ROW(0);
+    MSL_COMMAND(0, CO18);
+    MSL_ROW(1);
+    if (MSL_ADDITIONAL(1, DI11A0))
+        MSL_COMMAND(1, CO97);
+    MSL_ROW(2);
+    if (MSL_ADDITIONAL(2, DI11A0))
+        MSL_COMMAND(2, CO96);
+    MSL_ROW(3);
+    if (MSL_ADDITIONAL(3, DI11A0))
+        MSL_COMMAND(3, CO95);
+    MSL_ROW(4);
+    MSL_COMMAND(4, CO94);
+    MSL_ROW(5);
+    if (MSL_ADDITIONAL(5, DI11A0))
+        MSL_COMMAND(5, CO93);
+    MSL_ROW(6);
+    if (MSL_ADDITIONAL(6, DI11A0))
+        MSL_COMMAND(6, CO92);
+    MSL_ROW(7);
+    MSL_COMMAND(7, CO91);
+    MSL_ROW(8);
+    if (MSL_ADDITIONAL(8, DI11A0))
+        MSL_COMMAND(8, CO90);
+    MSL_ROW(9);
+    if (MSL_ADDITIONAL(9, DI11A0))
+        MSL_COMMAND(9, CO40);
+    MSL_ROW(10);
+    if (MSL_ADDITIONAL(10, DI11A0))
+        MSL_COMMAND(10, CO41);
+}
+
+static void state_ea_TO25(struct ge *ge)
+{
+    MSL_ROW(11);
+    if (MSL_CONDITION(11, L206_or_PC01))
+        MSL_COMMAND(11, CO31);
+}
+
+static void state_ea_TO30(struct ge *ge)
+{
+    MSL_ROW(12);
+    MSL_COMMAND(12, CI11);
+}
+
+static void state_ea_TO40(struct ge *ge)
+{
+    MSL_ROW(13);
+    if (MSL_ADDITIONAL(13, DI11A0))
+        MSL_COMMAND(13, CO02);
+}
+
+static void state_ea_TO50(struct ge *ge)
+{
+    MSL_ROW(14);
+    if (MSL_ADDITIONAL(14, DI83A0))
+        MSL_COMMAND(14, CI33);
+}
+
+static void state_ea_TI06(struct ge *ge)
+{
+    MSL_ROW(15);
+    MSL_COMMAND(15, CU00);
+}
+
+static const msl_clock_cb state_ea_compiled[END_OF_STATUS] = {
+    [TO10] = state_ea_TO10,
+    [TO25] = state_ea_TO25,
+    [TO30] = state_ea_TO30,
+    [TO40] = state_ea_TO40,
+    [TO50] = state_ea_TO50,
+    [TI06] = state_ea_TI06,
+};
+
+static void state_eb_TO10(struct ge *ge)
+{
+    MSL_ROW(0);
+    if (MSL_ADDITIONAL(0, DA25A0))
+        MSL_COMMAND(0, CO12);
+    MSL_ROW(1);
+    if (MSL_ADDITIONAL(1, DI11A0))
+        MSL_COMMAND(1, CO97);
+    MSL_ROW(2);
+    if (MSL_ADDITIONAL(2, DI11A0))
+        MSL_COMMAND(2, CO96);
+    MSL_ROW(3);
+    if (MSL_ADDITIONAL(3, DI11A0))
+        MSL_COMMAND(3, CO95);
+    MSL_ROW(4);
+    MSL_COMMAND(4, CO94);
+    MSL_ROW(5);
+    if (MSL_ADDITIONAL(5, DI11A0))
+        MSL_COMMAND(5, CO93);
+    MSL_ROW(6);
+    if (MSL_ADDITIONAL(6, DI11A0))
+        MSL_COMMAND(6, CO92);
+    MSL_ROW(7);
+    MSL_COMMAND(7, CO91);
+    MSL_ROW(8);
+    if (MSL_ADDITIONAL(8, DI11A0))
+        MSL_COMMAND(8, CO90);
+    MSL_ROW(9);
+    if (MSL_ADDITIONAL(9, DI11A0))
+        MSL_COMMAND(9, CO04);
+    MSL_ROW(10);
+    if (MSL_ADDITIONAL(10, DI11A0))
+        MSL_COMMAND(10, CO41);
+}
+
+static void state_eb_TO25(struct ge *ge)
+{
+    MSL_ROW(11);
+    if (MSL_CONDITION(11, L206_or_PC01))
+        MSL_COMMAND(11, CO31);
+}
+
+static void state_eb_TO30(struct ge *ge)
+{
+    MSL_ROW(12);
+    MSL_COMMAND(12, CI11);
+}
+
+static void state_eb_TO40(struct ge *ge)
+{
+    MSL_ROW(13);
+    if (MSL_ADDITIONAL(13, DI11A0))
+        MSL_COMMAND(13, CO02);
+}
+
+static void state_eb_TO50(struct ge *ge)
+{
+    MSL_ROW(14);
+    if (MSL_ADDITIONAL(14, DI82A0))
+        MSL_COMMAND(14, CI32);
+    MSL_ROW(15);
+    if (MSL_CONDITION(15, L207))
+        MSL_COMMAND(15, CE06);
+}
+
+static void state_eb_TI06(struct ge *ge)
+{
+    MSL_ROW(16);
+    if (MSL_ADDITIONAL(16, ED91A0) && MSL_CONDITION(16, state_eb_TI06_CI75))
+        MSL_COMMAND(16, CI75);
+    MSL_ROW(17);
+    if (MSL_CONDITION(17, state_eb_TI06_CE19))
+        MSL_COMMAND(17, CE19);
+    MSL_ROW(18);
+    MSL_COMMAND(18, CU00);
+    MSL_ROW(19);
+    if (MSL_ADDITIONAL(19, DI82A0))
+        MSL_COMMAND(19, CU13);
+}
+
+static const msl_clock_cb state_eb_compiled[END_OF_STATUS] = {
+    [TO10] = state_eb_TO10,
+    [TO25] = state_eb_TO25,
+    [TO30] = state_eb_TO30,
+    [TO40] = state_eb_TO40,
+    [TO50] = state_eb_TO50,
+    [TI06] = state_eb_TI06,
+};
+
+const struct msl_compiled_chart msl_compiled_charts[] = {
+    { state_80, state_80_compiled },
+    { state_E2_E3, state_E2_E3_compiled },
+    { state_E0, state_E0_compiled },
+    { state_E4, state_E4_compiled },
+    { state_E6, state_E6_compiled },
+    { state_E5, state_E5_compiled },
+    { state_E7, state_E7_compiled },
+    { state_64_65, state_64_65_compiled },
+    { state_00, state_00_compiled },
+    { state_08, state_08_compiled },
+    { state_c8, state_c8_compiled },
+    { state_d8, state_d8_compiled },
+    { state_d9, state_d9_compiled },
+    { state_da, state_da_compiled },
+    { state_db, state_db_compiled },
+    { state_dc, state_dc_compiled },
+    { state_cc, state_cc_compiled },
+    { state_ca, state_ca_compiled },
+    { state_a8, state_a8_compiled },
+    { state_a9, state_a9_compiled },
+    { state_aa, state_aa_compiled },
+    { state_ab, state_ab_compiled },
+    { state_b8, state_b8_compiled },
+    { state_b1, state_b1_compiled },
+    { state_b9, state_b9_compiled },
+    { state_ea, state_ea_compiled },
+    { state_eb, state_eb_compiled },
+    { 0, 0 }
+};
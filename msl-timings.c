@@ -1,12 +1,55 @@
 #include "msl-timings.h"
 #include "msl-comments.h"
+#include "profile.h"
 
 #define MSL_STATES_INCLUDED_BY_MSL_TIMINGS
 #include "msl-states.c"
 #undef MSL_STATES_INCLUDED_BY_MSL_TIMINGS
 
+/* The code generated by msl-compile runs the rows like msl_run_state(),
+ * with the same logs and profile counters, calling the functions
+ * directly. `n` is the index of the row in the rows of the state. */
+static inline uint8_t msl_check(struct ge *ge, uint16_t n, uint8_t value,
+                                uint8_t additional)
+{
+    ge_log(LOG_CONDS, "  time %-4s - %s %s\n",
+           ge_clock_name(ge->current_clock),
+           additional ? "additional" : "condition", value ? "true" : "false");
 
-struct msl_timing_state msl_timings[0xff] = {
+    if (!value && additional)
+        GE_PROFILE_ROW(ge, n, additional_false);
+    else if (!value)
+        GE_PROFILE_ROW(ge, n, condition_false);
+
+    return value;
+}
+
+#define MSL_ROW(n)                                                  \
+    do {                                                            \
+        GE_PROFILE_ROW(ge, n, runs);                                \
+        if (ge->trace || ge_log_enabled(LOG_REGS_V))                \
+            ge_print_registers_verbose(ge);                         \
+    } while (0)
+
+#define MSL_ADDITIONAL(n, f) msl_check(ge, n, f(ge), 1)
+#define MSL_CONDITION(n, f)  msl_check(ge, n, f(ge), 0)
+
+#define MSL_COMMAND(n, f)                                           \
+    do {                                                            \
+        ge_log(LOG_CMDS, "    %s\n", msl_comment_for_command(f));   \
+        GE_PROFILE_ROW(ge, n, fired);                               \
+        f(ge);                                                      \
+    } while (0)
+
+#include "msl-compiled.c"
+
+#undef MSL_ROW
+#undef MSL_ADDITIONAL
+#undef MSL_CONDITION
+#undef MSL_COMMAND
+
+
+const struct msl_timing_definition msl_timings[0x100] = {
     /* 00 */ {state_00},
     /* 01 */ { },
     /* 02 */ { },
@@ -262,15 +305,17 @@ struct msl_timing_state msl_timings[0xff] = {
     /* fc */ { },
     /* fd */ { },
     /* fe */ { },
+    /* ff */ { },
 };
 
 struct msl_command_comment {
     msl_command_cb command;
     const char * comment;
+    const char * name;
 };
 
 struct msl_command_comment comments[] = {
-#define X(command , comment) { command , #command " - " comment },
+#define X(command , comment) { command , #command " - " comment, #command },
     ENUMERATE_COMMANDS_COMMENTS
 #undef X
 };
@@ -283,3 +328,12 @@ const char *msl_comment_for_command(msl_command_cb command) {
     }
     return "[no comment]";
 }
+
+const char *msl_name_for_command(msl_command_cb command) {
+    for (int i = 0; i < sizeof(comments)/sizeof(struct msl_command_comment); i++) {
+        if (comments[i].command == command) {
+            return comments[i].name;
+        }
+    }
+    return "[unknown]";
+}
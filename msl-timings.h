@@ -5,6 +5,9 @@
 
 typedef void (*msl_command_cb)(struct ge*);
 
+/// Rows of a timing chart for a single clock, compiled by msl-compile
+typedef void (*msl_clock_cb)(struct ge*);
+
 /**
  * Timing chart row
  *
@@ -44,13 +47,55 @@ struct msl_timing_chart {
     uint8_t (*additional)(struct ge*);
 };
 
+/**
+ * Timing chart definition
+ *
+ * The timing chart of a state, as written in msl-timings.c.
+ */
+struct msl_timing_definition {
+    const struct msl_timing_chart *chart;
+};
+
 /**
  * Timing chart
  *
- * The timing chart for an entire state of the MSL.
+ * The timing chart for an entire state of the MSL, prepared by
+ * msl_init(). The states sharing a chart (e.g. 64/65) share it.
  */
 struct msl_timing_state {
     const struct msl_timing_chart *chart;
+
+    /**
+     * Rows of the chart grouped by clock
+     *
+     * A copy of the rows of `chart` in a single array shared by all the
+     * charts: the rows to be run at clock `c` are `rows[first[c]]` up to
+     * (excluding) `rows[first[c + 1]]`, in the same order as they appear
+     * in `chart`.
+     */
+    const struct msl_timing_chart *rows;
+    uint8_t first[END_OF_STATUS + 1];
+
+    /// Mask of the clocks having at least a row
+    uint32_t active_clocks;
+
+    /**
+     * Compiled chart
+     *
+     * The code generated for `chart` by msl-compile, indexed by clock
+     * (NULL where the chart has no rows). NULL if the chart has not been
+     * compiled.
+     */
+    const msl_clock_cb *compiled;
+
+    /// The state has no timing chart, running it is an error
+    uint8_t unimplemented;
+};
+
+/// A chart and the code generated for it by msl-compile
+struct msl_compiled_chart {
+    const struct msl_timing_chart *chart;
+    const msl_clock_cb *clocks;
 };
 
 /**
@@ -58,8 +103,18 @@ struct msl_timing_state {
  *
  * The timing states of the GE-120, recovered from the manuals.
  */
-extern struct msl_timing_state msl_timings[0xff];
+extern const struct msl_timing_definition msl_timings[0x100];
+
+/**
+ * Compiled timing charts
+ *
+ * Generated by msl-compile from msl-states.c, terminated by a NULL chart.
+ */
+extern const struct msl_compiled_chart msl_compiled_charts[];
 
 const char *msl_comment_for_command(msl_command_cb command);
 
+/// The name of a command, e.g. "CO00"
+const char *msl_name_for_command(msl_command_cb command);
+
 #endif /* MSL_TIMINGS_H */
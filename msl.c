@@ -5,48 +5,198 @@
 #include "msl-timings.h"
 #include "log.h"
 #include "ge.h"
+#include "profile.h"
 
-struct msl_timing_state* msl_get_state(uint8_t SO)
+#define MSL_MAX_STATES 64
+#define MSL_CACHE_LINE 64
+
+/* The rows of all the timing charts, grouped by chart and by clock */
+static struct msl_timing_chart msl_rows[MSL_MAX_ROWS]
+    __attribute__((aligned(MSL_CACHE_LINE)));
+static uint16_t msl_rows_used;
+
+/* The prepared charts, the first one traps the unimplemented states */
+static struct msl_timing_state msl_states[MSL_MAX_STATES] = {
+    { .active_clocks = GE_ALL_CLOCKS, .unimplemented = 1 },
+};
+static uint8_t msl_states_used = 1;
+
+/* Index in msl_states of the chart of every state */
+static uint8_t msl_state_index[0x100];
+
+static const msl_clock_cb *msl_find_compiled(const struct msl_timing_chart *chart)
 {
-    struct msl_timing_state *state = &msl_timings[SO];
+    const struct msl_compiled_chart *compiled;
+
+    for (compiled = msl_compiled_charts; compiled->chart; compiled++) {
+        if (compiled->chart == chart)
+            return compiled->clocks;
+    }
 
-    return (!state->chart)
-        ? NULL
-        : state;
+    return NULL;
 }
 
-void msl_run_state(struct ge* ge, struct msl_timing_state *state)
+static int msl_init_state(struct msl_timing_state *state,
+                          const struct msl_timing_chart *chart)
 {
+    const struct msl_timing_chart *row;
+    struct msl_timing_chart *rows;
+    uint16_t count = 0;
+    uint8_t n = 0;
+    int c;
+
+    for (row = chart; row->clock < END_OF_STATUS; row++)
+        count++;
+
+    if (count > MSL_MAX_ROWS - msl_rows_used || count > UINT8_MAX)
+        return -1;
+
+    rows = &msl_rows[msl_rows_used];
+    msl_rows_used += count;
+
+    for (c = 0; c < END_OF_STATUS; c++) {
+        state->first[c] = n;
+
+        for (row = chart; row->clock < END_OF_STATUS; row++) {
+            if (row->clock == c)
+                rows[n++] = *row;
+        }
+
+        if (n > state->first[c])
+            state->active_clocks |= 1 << c;
+    }
+
+    state->first[END_OF_STATUS] = n;
+    state->chart = chart;
+    state->rows = rows;
+    state->compiled = msl_find_compiled(chart);
+    return 0;
+}
+
+void msl_init(void)
+{
+    static uint8_t initialized = 0;
     const struct msl_timing_chart *chart;
-    uint32_t i = 0;
+    int i, j;
+
+    if (initialized)
+        return;
 
-    do {
-        const char *clock_name = ge_clock_name(ge->current_clock);
-        chart = &state->chart[i++];
+    for (i = 0; i < 0x100; i++) {
+        chart = msl_timings[i].chart;
 
-        if (chart->clock != ge->current_clock)
+        if (!chart)
             continue;
 
-        ge_print_registers_verbose(ge);
+        /* states sharing the same chart (e.g. 64/65) share the rows */
+        for (j = 1; j < msl_states_used; j++) {
+            if (msl_states[j].chart == chart)
+                break;
+        }
+
+        if (j == msl_states_used) {
+            if (j == MSL_MAX_STATES || msl_init_state(&msl_states[j], chart) != 0) {
+                ge_log(LOG_ERR, "no space left to prepare timing chart %02x\n", i);
+                continue;
+            }
+
+            msl_states_used++;
+        }
+
+        msl_state_index[i] = j;
+    }
+
+    initialized = 1;
+}
+
+struct msl_timing_state* msl_get_state(uint8_t SO)
+{
+    return &msl_states[msl_state_index[SO]];
+}
+
+uint16_t msl_rows_count(void)
+{
+    return msl_rows_used;
+}
+
+const struct msl_timing_chart *msl_get_row(uint16_t i, uint8_t *state)
+{
+    const struct msl_timing_state *s;
+    int j;
+
+    for (j = 0; j < 0x100; j++) {
+        s = &msl_states[msl_state_index[j]];
+
+        if (s->rows && i >= s->rows - msl_rows &&
+            i < s->rows - msl_rows + s->first[END_OF_STATUS])
+        {
+            *state = j;
+            break;
+        }
+    }
+
+    return &msl_rows[i];
+}
+
+/* The trap for the states without a timing chart */
+static int msl_unimplemented(struct ge *ge)
+{
+    ge_log(LOG_ERR, "no timing charts found for state %02X\n", ge->rSA);
+    return 1;
+}
+
+int msl_run_state(struct ge* ge, struct msl_timing_state *state)
+{
+    const struct msl_timing_chart *chart;
+    msl_clock_cb compiled;
+    uint8_t i;
+
+    if (state->unimplemented)
+        return msl_unimplemented(ge);
+
+    if (ge->profile)
+        ge->profile_rows = &ge->profile->rows[state->rows - msl_rows];
+
+    if (state->compiled && !ge->msl_interpreted) {
+        compiled = state->compiled[ge->current_clock];
+        if (compiled)
+            compiled(ge);
+        return 0;
+    }
+
+    for (i = state->first[ge->current_clock];
+         i < state->first[ge->current_clock + 1];
+         i++)
+    {
+        chart = &state->rows[i];
+        GE_PROFILE_ROW(ge, i, runs);
+
+        if (ge->trace || ge_log_enabled(LOG_REGS_V))
+            ge_print_registers_verbose(ge);
 
         if (chart->additional) {
             if (!chart->additional(ge)) {
-                ge_log(LOG_CONDS, "  time %-4s - additional false\n", clock_name);
+                ge_log(LOG_CONDS, "  time %-4s - additional false\n", ge_clock_name(ge->current_clock));
+                GE_PROFILE_ROW(ge, i, additional_false);
                 continue;
             }
-            ge_log(LOG_CONDS, "  time %-4s - additional true\n", clock_name);
+            ge_log(LOG_CONDS, "  time %-4s - additional true\n", ge_clock_name(ge->current_clock));
         }
 
         if (chart->condition) {
             if (!chart->condition(ge)) {
-                ge_log(LOG_CONDS, "  time %-4s - condition false\n", clock_name);
+                ge_log(LOG_CONDS, "  time %-4s - condition false\n", ge_clock_name(ge->current_clock));
+                GE_PROFILE_ROW(ge, i, condition_false);
                 continue;
             }
-            ge_log(LOG_CONDS, "  time %-4s - condition true\n", clock_name);
+            ge_log(LOG_CONDS, "  time %-4s - condition true\n", ge_clock_name(ge->current_clock));
         }
 
 
         ge_log(LOG_CMDS, "    %s\n", msl_comment_for_command(chart->command));
+        GE_PROFILE_ROW(ge, i, fired);
         chart->command(ge);
-    } while (chart->clock < END_OF_STATUS);
+    }
+
+    return 0;
 }
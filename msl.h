@@ -5,6 +5,23 @@
 #include "ge.h"
 
 struct msl_timing_state;
+struct msl_timing_chart;
+
+/// Maximum number of rows of all the timing charts together
+#define MSL_MAX_ROWS 1024
+
+/**
+ * Prepares the timing charts
+ *
+ * Copies the rows of every timing chart in a single array, grouped by
+ * clock, so that running a state at a given clock does not need to scan
+ * the whole chart, and indexes the charts by state. It is called by
+ * ge_init(), and only does its work once.
+ *
+ * It is not thread safe: when running emulators on multiple threads,
+ * call it before starting them.
+ */
+void msl_init(void);
 
 /**
  * Gets timing state
@@ -12,19 +29,38 @@ struct msl_timing_state;
  * Returns the timing definitions for a given state
  *
  * @param  state the state as used by the SO cpu sequencer
- * @return a pointer to a static definition of the given state
+ * @return a pointer to a static definition of the given state. The
+ *         states without a timing chart share a definition that traps
+ *         when it is run, see msl_run_state().
  */
 struct msl_timing_state* msl_get_state(uint8_t state);
 
+/// Number of rows prepared by msl_init()
+uint16_t msl_rows_count(void);
+
+/**
+ * Gets a prepared row
+ *
+ * @param i     index of the row, less than msl_rows_count()
+ * @param state set to the first state whose chart has the row
+ * @return the row, as run by msl_run_state()
+ */
+const struct msl_timing_chart *msl_get_row(uint16_t i, uint8_t *state);
+
 /**
  * Runs a machine state
  *
  * Modifies the machine state by running the given state according
  * to the current emualted clock time.
  *
+ * The rows are run by the code generated from the chart by msl-compile,
+ * unless the chart has not been compiled or `ge->msl_interpreted` is
+ * set: then the chart is interpreted. Both give the same results.
+ *
  * @param ge    the emulator state
  * @param state the state to run
+ * @return 0 on success, 1 if the state has no timing chart
  */
-void msl_run_state(struct ge* ge, struct msl_timing_state *state);
+int msl_run_state(struct ge* ge, struct msl_timing_state *state);
 
 #endif /* MSL_H */
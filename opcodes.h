@@ -35,6 +35,14 @@
 #define JS1_OPCODE  0x53
 #define JS1_2NDCHAR 0x80
 
+/* Jumps on condition, the condition is in the high nibble of the
+ * second character */
+#define JCOND_OPCODE  0x47
+#define JC_CONDITION  0x10
+#define JE_CONDITION  0x20
+#define JNE_CONDITION 0xd0
+#define JU_CONDITION  0xf0
+
 #define JRT_OPCODE  0x41
 #define JC_OPCODE   0x43
 #define LA_OPCODE   0x68
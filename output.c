@@ -0,0 +1,188 @@
+#include <string.h>
+
+#include "output.h"
+#include "bit.h"
+#include "deck.h"
+#include "log.h"
+#include "mem.h"
+#include "reader.h"
+#include "signals.h"
+
+/* Characters queued to the writer at once */
+#define CHUNK 256
+
+static uint8_t output_selected(struct ge *ge, struct ge_output *out)
+{
+    if (out->connector == &ge->ST3)
+        return PC131(ge);
+
+    return PC141(ge);
+}
+
+/* The characters of the transfer, as the channel would send them, up to
+ * `length` of them padded with zeros if not 0 */
+static int output_transfer(struct ge *ge, struct ge_output *out, size_t length)
+{
+    uint8_t chars[CHUNK + 1];
+    uint16_t addr = ge->rV1;
+    int step = BIT(ge->rL2, 5) ? -1 : 1;
+    size_t count = (size_t)ge->rL1 + 1, i, n = 0;
+
+    if (length == 0)
+        length = count;
+
+    for (i = 0; i < length; i++) {
+        if (i >= count) {
+            chars[n++] = 0;
+        } else if (BIT(ge->rL2, 4)) {
+            chars[n++] = ge_mem_read(ge, addr);
+            addr += step;
+        } else if (i % 2 == 0) {
+            chars[n++] = ge_mem_read(ge, addr) >> 4;
+        } else {
+            chars[n++] = ge_mem_read(ge, addr) & 0x0f;
+            addr += step;
+        }
+
+        if (n == CHUNK) {
+            if (ge_writer_put(&out->writer, chars, n) != 0)
+                return -1;
+            n = 0;
+        }
+    }
+
+    if (out->kind == GE_OUTPUT_PRINTER)
+        chars[n++] = '\n';
+
+    return ge_writer_put(&out->writer, chars, n);
+}
+
+static int output_write(struct ge *ge, struct ge_output *out)
+{
+    size_t length = 0;
+
+    if (out->kind == GE_OUTPUT_PUNCH)
+        length = ge->rRE == READER_put_binary ? 2 * GE_DECK_COLUMNS : GE_DECK_COLUMNS;
+
+    ge_log(LOG_PERI, "%s: output transfer, command %02x, %u characters\n",
+           out->connector->name, ge->rRE, ge->rL1 + 1);
+
+    out->records++;
+    return output_transfer(ge, out, length);
+}
+
+static int output_on_clock(struct ge *ge, void *ctx)
+{
+    struct ge_output *out = ctx;
+
+    if (out->captured) {
+        /* the transfer ends through ea and eb */
+        if (ge->rSO == 0xb8 || ge->rSO == 0xea || ge->rSO == 0xeb)
+            return 0;
+
+        out->captured = 0;
+        ge_peri_wake_on_clocks(&out->peri, 0);
+    }
+
+    if (ge->rSO != 0xb8 || !BIT(ge->rL2, 6) || !output_selected(ge, out))
+        return 0;
+
+    out->captured = 1;
+    if (output_write(ge, out) != 0)
+        return -1;
+
+    /* End the transfer as the channel would after the last character:
+     * the cycles go back to the CPU (RC00, as CI39 does) and the end of
+     * the transfer (PEC1, as the `fine` of the units) brings the machine
+     * out of b8 to the end of the PER */
+    ge->RC00 = 1;
+    ge->PEC1 = 1;
+    ge_peri_wake_on_clocks(&out->peri, GE_CLOCK_BIT(TO60));
+    return 0;
+}
+
+/* States ea and eb write RO back at V1, where the channel register would
+ * hold the last character read: keep the memory as it is */
+static int output_on_pulse(struct ge *ge, void *ctx)
+{
+    (void)ctx;
+
+    if (ge->rSA == 0xea || ge->rSA == 0xeb) {
+        ge->rRO = ge_mem_read(ge, ge->rVO);
+        NI_changed(ge);
+    }
+
+    return 0;
+}
+
+int ge_output_open(struct ge_output *out, enum ge_output_kind kind, const char *path)
+{
+    memset(out, 0, sizeof(*out));
+    out->kind = kind;
+
+    out->file = fopen(path, "wb");
+    if (out->file == NULL)
+        return -1;
+
+    if (ge_writer_init(&out->writer, out->file, GE_WRITER_SIZE) != 0) {
+        fclose(out->file);
+        out->file = NULL;
+        return -1;
+    }
+
+    return 0;
+}
+
+int ge_output_close(struct ge_output *out)
+{
+    int r;
+
+    if (out->file == NULL)
+        return 0;
+
+    r = ge_writer_deinit(&out->writer);
+    if (fclose(out->file) != 0)
+        r = -1;
+
+    out->file = NULL;
+    return r;
+}
+
+int ge_output_register(struct ge *ge, struct ge_output *out,
+                       struct ge_connector *connector)
+{
+    if (connector != &ge->ST3 && connector != &ge->ST4)
+        return -1;
+
+    out->connector = connector;
+    out->peri.on_pulse = output_on_pulse;
+    out->peri.on_clock = output_on_clock;
+    out->peri.ctx = out;
+
+    if (ge_register_peri(ge, &out->peri) != 0)
+        return -1;
+
+    /* only while a transfer ends */
+    ge_peri_wake_on_clocks(&out->peri, 0);
+    return 0;
+}
+
+int ge_output_parse(const char *spec, enum ge_output_kind *kind, const char **path)
+{
+    const char *colon = strchr(spec, ':');
+
+    if (colon == NULL)
+        return -1;
+
+#define X(k, name)                                                  \
+    if ((size_t)(colon - spec) == strlen(#name) &&                  \
+        strncmp(spec, #name, colon - spec) == 0) {                  \
+        *kind = GE_OUTPUT_##k;                                      \
+        *path = colon + 1;                                          \
+        return 0;                                                   \
+    }
+    ENUMERATE_OUTPUT_KINDS
+#undef X
+
+    return -1;
+}
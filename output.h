@@ -0,0 +1,92 @@
+/**
+ * @file  output.h
+ * @brief Output units on the ST3 and ST4 connectors
+ *
+ * A line printer or a card punch attached to a connector, capturing the
+ * output transfers (PER with an output Z character, L2 bit 6) to the
+ * unit and writing them to a file through a writer thread (see
+ * writer.h).
+ *
+ * A transfer is captured when the machine starts waiting for the unit
+ * (state b8) with the connector selected on channel 1 (PC131 or PC141):
+ * the characters are taken from the memory as the transfer describes
+ * them, L1 + 1 characters from V1 (downwards with L2 bit 5), two per
+ * byte, high nibble first, unless L2 bit 4 (no packing) is set.
+ *
+ * The printer writes a line for every transfer. The punch writes a card
+ * for every transfer, in the format of the card decks (see deck.h), so
+ * that its output can be read back: 2 * GE_DECK_COLUMNS characters for
+ * put binary, GE_DECK_COLUMNS for the other commands, padded with zeros.
+ *
+ * The channel 1 output phase is not in the timing charts (the rows of
+ * state b9 are disabled by L2 bit 6): once the transfer is captured, the
+ * unit ends it at once, and the PER completes as after the last
+ * character, leaving the memory unchanged.
+ */
+
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "ge.h"
+#include "writer.h"
+
+#define ENUMERATE_OUTPUT_KINDS \
+    X(PRINTER, printer)        \
+    X(PUNCH,   punch)
+
+enum ge_output_kind {
+#define X(kind, name) GE_OUTPUT_##kind,
+    ENUMERATE_OUTPUT_KINDS
+#undef X
+};
+
+/// Output unit
+struct ge_output {
+    struct ge_peri peri;
+    struct ge_connector *connector; ///< ST3 or ST4
+    enum ge_output_kind kind;
+
+    FILE *file;
+    struct ge_writer writer;
+
+    uint8_t captured; ///< The current transfer has been captured
+    uint64_t records; ///< Lines or cards written
+};
+
+/**
+ * Open an output unit
+ *
+ * @param out  the unit to open
+ * @param kind printer or punch
+ * @param path the file to write, truncated
+ * @return 0 on success, -1 if the file or the writer cannot be created
+ */
+int ge_output_open(struct ge_output *out, enum ge_output_kind kind, const char *path);
+
+/**
+ * Close an output unit
+ *
+ * Waits for the records to be written.
+ *
+ * @return 0 on success, -1 on write errors
+ */
+int ge_output_close(struct ge_output *out);
+
+/**
+ * Attach the unit to a connector of `ge`, ST3 or ST4
+ *
+ * @return 0 on success, -1 on errors
+ */
+int ge_output_register(struct ge *ge, struct ge_output *out,
+                       struct ge_connector *connector);
+
+/**
+ * Parse an output unit option, `kind:path`
+ *
+ * @return 0 on success, -1 if the kind is not known
+ */
+int ge_output_parse(const char *spec, enum ge_output_kind *kind, const char **path);
+
+#endif /* OUTPUT_H */
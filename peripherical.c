@@ -1,6 +1,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <poll.h>
+
 #include "ge.h"
 #include "peripherical.h"
 
@@ -10,7 +12,9 @@ int ge_peri_on_pulses(struct ge *ge)
     int r;
 
     for (p = ge->peri; p != NULL; p = p->next) {
-        if (p->on_pulse == NULL)
+        if (p->on_pulse == NULL || !p->awake)
+            continue;
+        if (!(p->clocks & GE_CLOCK_BIT(ge->current_clock)))
             continue;
         r = p->on_pulse(ge, p->ctx);
         if (r != 0)
@@ -19,6 +23,59 @@ int ge_peri_on_pulses(struct ge *ge)
     return 0;
 }
 
+static uint8_t ge_peri_is_readable(int fd)
+{
+    struct pollfd pfd = { .fd = fd, .events = POLLIN };
+
+    return poll(&pfd, 1, 0) > 0 && (pfd.revents & (POLLIN | POLLHUP | POLLERR));
+}
+
+void ge_peri_schedule(struct ge *ge)
+{
+    struct ge_peri *p;
+
+    ge->peri_clocks = 0;
+
+    for (p = ge->peri; p != NULL; p = p->next) {
+        if (p->on_pulse == NULL)
+            continue;
+
+        p->awake = 1;
+
+        if (p->period) {
+            if (p->countdown) {
+                p->countdown--;
+                p->awake = 0;
+                continue;
+            }
+
+            p->countdown = p->period - 1;
+        }
+
+        if (p->fd >= 0)
+            p->awake = ge_peri_is_readable(p->fd);
+
+        if (p->awake)
+            ge->peri_clocks |= p->clocks;
+    }
+}
+
+void ge_peri_wake_on_clocks(struct ge_peri *p, uint32_t clocks)
+{
+    p->clocks = clocks & GE_ALL_CLOCKS;
+}
+
+void ge_peri_wake_every(struct ge_peri *p, uint32_t cycles)
+{
+    p->period = cycles;
+    p->countdown = 0;
+}
+
+void ge_peri_wake_on_fd(struct ge_peri *p, int fd)
+{
+    p->fd = fd;
+}
+
 int ge_peri_on_clock(struct ge *ge)
 {
     int r;
@@ -64,6 +121,15 @@ int ge_register_peri(struct ge *ge, struct ge_peri *p)
     *prec_next = p;
     p->next = NULL;
 
+    p->clocks = GE_ALL_CLOCKS;
+    p->period = 0;
+    p->countdown = 0;
+    p->fd = -1;
+
+    /* until the next ge_peri_schedule() */
+    p->awake = 1;
+    ge->peri_clocks |= p->clocks;
+
     if (p->init != NULL)
         return p->init(ge, p->ctx);
 
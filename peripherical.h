@@ -5,6 +5,14 @@
 
 int ge_peri_on_clock(struct ge *ge);
 int ge_peri_on_pulses(struct ge *ge);
+
+/**
+ * Decide which peripherals are awake in the cycle
+ *
+ * Called at the first clock of every cycle, before ge_peri_on_clock().
+ * Updates `ge->peri_clocks`.
+ */
+void ge_peri_schedule(struct ge *ge);
 int ge_peri_deinit(struct ge *ge);
 
 #endif /* PERI_H */
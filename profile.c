@@ -0,0 +1,466 @@
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "bit.h"
+#include "profile.h"
+#include "msl-timings.h"
+#include "mem.h"
+#include "opcodes.h"
+
+#define MAX_COMMANDS MSL_MAX_ROWS
+
+/* Width of the bar of the hottest instruction in the listing */
+#define LISTING_BAR 20
+
+/* The states fetching the instructions, i.e. the alpha phase */
+#define FETCH_STATE(s) ((s) == 0xe2 || (s) == 0xe3)
+
+/* A line of the report */
+struct entry {
+    uint16_t index;
+    uint64_t key;
+};
+
+/* The rows run by the same command */
+struct command {
+    msl_command_cb command;
+    uint64_t fired;
+};
+
+void ge_profile_init(struct ge_profile *profile)
+{
+    memset(profile, 0, sizeof(*profile));
+}
+
+void ge_set_profile(struct ge *ge, struct ge_profile *profile)
+{
+    ge->profile = profile;
+    ge->profile_rows = NULL;
+}
+
+uint64_t ge_profile_ticks(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+const char *ge_profile_ticks_unit(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return "tsc";
+#else
+    return "ns";
+#endif
+}
+
+void ge_profile_pulse(struct ge *ge, uint64_t ticks)
+{
+    struct ge_profile_state *s = &ge->profile->states[ge->rSA];
+
+    s->pulses++;
+    s->ticks += ticks;
+
+    /* the last clock of the cycle has been run */
+    if (ge->current_clock == TO00)
+        s->cycles++;
+}
+
+void ge_profile_merge(struct ge_profile *dst, const struct ge_profile *src)
+{
+    int i;
+
+    for (i = 0; i < 0x100; i++) {
+        dst->states[i].cycles += src->states[i].cycles;
+        dst->states[i].pulses += src->states[i].pulses;
+        dst->states[i].ticks  += src->states[i].ticks;
+    }
+
+    for (i = 0; i < MSL_MAX_ROWS; i++) {
+        dst->rows[i].runs             += src->rows[i].runs;
+        dst->rows[i].fired            += src->rows[i].fired;
+        dst->rows[i].additional_false += src->rows[i].additional_false;
+        dst->rows[i].condition_false  += src->rows[i].condition_false;
+    }
+}
+
+/* Largest key first, then by index */
+static int entry_cmp(const void *a, const void *b)
+{
+    const struct entry *x = a, *y = b;
+
+    if (x->key != y->key)
+        return x->key < y->key ? 1 : -1;
+
+    return x->index - y->index;
+}
+
+static int sorted_states(const struct ge_profile *profile, struct entry *out)
+{
+    int i, n = 0;
+
+    for (i = 0; i < 0x100; i++) {
+        if (profile->states[i].pulses == 0)
+            continue;
+
+        out[n].index = i;
+        out[n].key = profile->states[i].cycles;
+        n++;
+    }
+
+    qsort(out, n, sizeof(*out), entry_cmp);
+    return n;
+}
+
+static int sorted_commands(const struct ge_profile *profile,
+                           struct command *commands, struct entry *out)
+{
+    const struct msl_timing_chart *row;
+    uint16_t i, rows = msl_rows_count();
+    uint8_t state;
+    int j, n = 0;
+
+    for (i = 0; i < rows; i++) {
+        row = msl_get_row(i, &state);
+
+        for (j = 0; j < n; j++) {
+            if (commands[j].command == row->command)
+                break;
+        }
+
+        if (j == n) {
+            commands[n].command = row->command;
+            commands[n].fired = 0;
+            n++;
+        }
+
+        commands[j].fired += profile->rows[i].fired;
+    }
+
+    for (j = 0; j < n; j++) {
+        out[j].index = j;
+        out[j].key = commands[j].fired;
+    }
+
+    qsort(out, n, sizeof(*out), entry_cmp);
+
+    /* only the commands that have been run */
+    while (n > 0 && out[n - 1].key == 0)
+        n--;
+
+    return n;
+}
+
+static int sorted_rows(const struct ge_profile *profile, struct entry *out)
+{
+    uint16_t i, rows = msl_rows_count();
+    int n = 0;
+
+    for (i = 0; i < rows; i++) {
+        if (profile->rows[i].runs == 0)
+            continue;
+
+        out[n].index = i;
+        out[n].key = profile->rows[i].runs;
+        n++;
+    }
+
+    qsort(out, n, sizeof(*out), entry_cmp);
+    return n;
+}
+
+static double percent(uint64_t part, uint64_t total)
+{
+    return total ? 100.0 * part / total : 0;
+}
+
+void ge_profile_print(const struct ge_profile *profile, FILE *f)
+{
+    static struct command commands[MAX_COMMANDS];
+    static struct entry entries[MSL_MAX_ROWS];
+    const struct ge_profile_state *s;
+    const struct ge_profile_row *r;
+    const struct msl_timing_chart *row;
+    uint64_t cycles = 0, pulses = 0, ticks = 0;
+    uint8_t state = 0;
+    int i, n;
+
+    for (i = 0; i < 0x100; i++) {
+        cycles += profile->states[i].cycles;
+        pulses += profile->states[i].pulses;
+        ticks  += profile->states[i].ticks;
+    }
+
+    fprintf(f, "%llu cycles, %llu pulses, %llu %s\n\n",
+            (unsigned long long)cycles, (unsigned long long)pulses,
+            (unsigned long long)ticks, ge_profile_ticks_unit());
+
+    fprintf(f, "state      cycles       %%      pulses         ticks       %%\n");
+    n = sorted_states(profile, entries);
+    for (i = 0; i < n; i++) {
+        s = &profile->states[entries[i].index];
+        fprintf(f, "   %02x %12llu %6.2f%% %11llu %13llu %6.2f%%\n",
+                entries[i].index,
+                (unsigned long long)s->cycles, percent(s->cycles, cycles),
+                (unsigned long long)s->pulses,
+                (unsigned long long)s->ticks, percent(s->ticks, ticks));
+    }
+
+    fprintf(f, "\ncommand       fired\n");
+    n = sorted_commands(profile, commands, entries);
+    for (i = 0; i < n; i++) {
+        fprintf(f, "  %-6s %12llu\n",
+                msl_name_for_command(commands[entries[i].index].command),
+                (unsigned long long)entries[i].key);
+    }
+
+    fprintf(f, "\nstate clock command         runs        fired   additional    condition\n");
+    n = sorted_rows(profile, entries);
+    for (i = 0; i < n; i++) {
+        row = msl_get_row(entries[i].index, &state);
+        r = &profile->rows[entries[i].index];
+        fprintf(f, "   %02x %-5s %-6s %12llu %12llu %12llu %12llu\n",
+                state, ge_clock_name(row->clock), msl_name_for_command(row->command),
+                (unsigned long long)r->runs, (unsigned long long)r->fired,
+                (unsigned long long)r->additional_false,
+                (unsigned long long)r->condition_false);
+    }
+}
+
+int ge_profile_write_json(const struct ge_profile *profile, FILE *f)
+{
+    static struct command commands[MAX_COMMANDS];
+    static struct entry entries[MSL_MAX_ROWS];
+    const struct ge_profile_state *s;
+    const struct ge_profile_row *r;
+    const struct msl_timing_chart *row;
+    uint8_t state = 0;
+    int i, n;
+
+    fprintf(f, "{\n  \"ticks_unit\": \"%s\",\n  \"states\": [", ge_profile_ticks_unit());
+
+    n = sorted_states(profile, entries);
+    for (i = 0; i < n; i++) {
+        s = &profile->states[entries[i].index];
+        fprintf(f, "%s\n    {\"state\": \"%02x\", \"cycles\": %llu, \"pulses\": %llu, \"ticks\": %llu}",
+                i ? "," : "", entries[i].index,
+                (unsigned long long)s->cycles, (unsigned long long)s->pulses,
+                (unsigned long long)s->ticks);
+    }
+
+    fprintf(f, "\n  ],\n  \"commands\": [");
+
+    n = sorted_commands(profile, commands, entries);
+    for (i = 0; i < n; i++) {
+        fprintf(f, "%s\n    {\"command\": \"%s\", \"fired\": %llu}",
+                i ? "," : "",
+                msl_name_for_command(commands[entries[i].index].command),
+                (unsigned long long)entries[i].key);
+    }
+
+    fprintf(f, "\n  ],\n  \"rows\": [");
+
+    n = sorted_rows(profile, entries);
+    for (i = 0; i < n; i++) {
+        row = msl_get_row(entries[i].index, &state);
+        r = &profile->rows[entries[i].index];
+        fprintf(f, "%s\n    {\"state\": \"%02x\", \"clock\": \"%s\", \"command\": \"%s\", "
+                   "\"runs\": %llu, \"fired\": %llu, "
+                   "\"additional_false\": %llu, \"condition_false\": %llu}",
+                i ? "," : "", state, ge_clock_name(row->clock),
+                msl_name_for_command(row->command),
+                (unsigned long long)r->runs, (unsigned long long)r->fired,
+                (unsigned long long)r->additional_false,
+                (unsigned long long)r->condition_false);
+    }
+
+    fprintf(f, "\n  ]\n}\n");
+
+    return ferror(f) ? -1 : 0;
+}
+
+void ge_guest_profile_init(struct ge_guest_profile *profile)
+{
+    memset(profile, 0, sizeof(*profile));
+    profile->current = GE_GUEST_PROFILE_NONE;
+}
+
+void ge_set_guest_profile(struct ge *ge, struct ge_guest_profile *profile)
+{
+    ge->guest_profile = profile;
+}
+
+void ge_guest_profile_cycle(struct ge *ge, uint8_t end)
+{
+    struct ge_guest_profile *p = ge->guest_profile;
+
+    if (!end) {
+        p->cycle_po = ge->rPO;
+        return;
+    }
+
+    /* the instruction is read from PO in the alpha phase */
+    if (FETCH_STATE(ge->rSA)) {
+        p->current = p->cycle_po;
+        p->fetches[p->current]++;
+    }
+
+    if (p->current != GE_GUEST_PROFILE_NONE)
+        p->cycles[p->current]++;
+}
+
+void ge_guest_profile_insn(struct ge *ge, uint16_t addr, unsigned cycles)
+{
+    struct ge_guest_profile *p = ge->guest_profile;
+
+    p->current = addr;
+    p->fetches[addr]++;
+    p->cycles[addr] += cycles;
+}
+
+/* The mnemonics, as in software/loader.txt. The jumps on condition have
+ * the same operation code, and the condition in the second character */
+static const char *mnemonic(uint8_t op, uint8_t c2)
+{
+    switch (op) {
+        case LON_OPCODE:
+            switch (c2) {
+                case ENS_2NDCHAR:  return "ENS";
+                case INS_2NDCHAR:  return "INS";
+                case LOFF_2NDCHAR: return "LOFF";
+                case LON_2NDCHAR:  return "LON";
+                case LOLL_2NDCHAR: return "LOLL";
+            }
+            return "?";
+
+        case JS1_OPCODE:
+            switch (c2) {
+                case JIE_2NDCHAR: return "JIE";
+                case JS2_2NDCHAR: return "JS2";
+                case JS1_2NDCHAR: return "JS1";
+            }
+            return "?";
+
+        case JCOND_OPCODE:
+            switch (c2 & 0xf0) {
+                case JC_CONDITION:  return "JC";
+                case JE_CONDITION:  return "JE";
+                case JNE_CONDITION: return "JNE";
+                case JU_CONDITION:  return "JU";
+            }
+            return "J";
+
+        case NOP2_OPCODE: return "NOP2";
+        case HLT_OPCODE:  return "HLT";
+        case JRT_OPCODE:  return "JRT";
+        case JC_OPCODE:   return "JC";
+        case LA_OPCODE:   return "LA";
+        case TM_OPCODE:   return "TM";
+        case MVI_OPCODE:  return "MVI";
+        case NI_OPCODE:   return "NI";
+        case CMI_OPCODE:  return "CMI";
+        case CI_OPCODE:   return "CI";
+        case XI_OPCODE:   return "XI";
+        case PERI_OPCODE: return "PERI";
+        case LPSR_OPCODE: return "LPSR";
+        case PER_OPCODE:  return "PER";
+        case STR_OPCODE:  return "STR";
+        case LR_OPCODE:   return "LR";
+        case CMR_OPCODE:  return "CMR";
+        case AMR_OPCODE:  return "AMR";
+        case SMR_OPCODE:  return "SMR";
+        case MVC_OPCODE:  return "MVC";
+        case NC_OPCODE:   return "NC";
+        case CMC_OPCODE:  return "CMC";
+        case OC_OPCODE:   return "OC";
+        case XC_OPCODE:   return "XC";
+        case UPK_OPCODE:  return "UPK";
+        case SR_OPCODE:   return "SR";
+        case PK_OPCODE:   return "PK";
+        case SL_OPCODE:   return "SL";
+        case TL_OPCODE:   return "TL";
+        case EDT_OPCODE:  return "EDT";
+        case MVP_OPCODE:  return "MVP";
+        case CMP_OPCODE:  return "CMP";
+        case AP_OPCODE:   return "AP";
+        case SP_OPCODE:   return "SP";
+        case MP_OPCODE:   return "MP";
+        case DP_OPCODE:   return "DP";
+        case PKS_OPCODE:  return "PKS";
+        case UPKS_OPCODE: return "UPKS";
+        case MVQ_OPCODE:  return "MVQ";
+        case CMQ_OPCODE:  return "CMQ";
+        case AD_OPCODE:   return "AD";
+        case SD_OPCODE:   return "SD";
+        case AB_OPCODE:   return "AB";
+        case SB_OPCODE:   return "SB";
+    }
+
+    return "?";
+}
+
+/* The characters of the instruction, grouped as in software/loader.txt:
+ * the format is given by FO06 and FO07 (see state E0) */
+static void format_insn(struct ge *ge, uint16_t addr, char *buf, size_t size)
+{
+    uint8_t c[6];
+    int i, len;
+
+    c[0] = ge_mem_read(ge, addr);
+    len = 2 + 2 * BIT(c[0], 6) + 2 * BIT(c[0], 7);
+
+    for (i = 1; i < len; i++)
+        c[i] = ge_mem_read(ge, addr + i);
+
+    if (len == 2)
+        snprintf(buf, size, "%02X %02X", c[0], c[1]);
+    else if (len == 4)
+        snprintf(buf, size, "%02X %02X %02X%02X", c[0], c[1], c[2], c[3]);
+    else
+        snprintf(buf, size, "%02X %02X %02X%02X %02X%02X",
+                 c[0], c[1], c[2], c[3], c[4], c[5]);
+}
+
+void ge_guest_profile_print(const struct ge_guest_profile *profile,
+                            struct ge *ge, FILE *f)
+{
+    uint64_t total = 0, hottest = 0;
+    char chars[0x20], bar[LISTING_BAR + 1];
+    uint32_t addr;
+    int len;
+
+    for (addr = 0; addr < MEM_SIZE; addr++) {
+        total += profile->cycles[addr];
+        if (profile->cycles[addr] > hottest)
+            hottest = profile->cycles[addr];
+    }
+
+    fprintf(f, "ADDR INSN CHARACTERS             FETCHES       CYCLES       %%\n");
+
+    for (addr = 0; addr < MEM_SIZE; addr++) {
+        if (profile->fetches[addr] == 0)
+            continue;
+
+        format_insn(ge, addr, chars, sizeof(chars));
+
+        len = hottest ? LISTING_BAR * profile->cycles[addr] / hottest : 0;
+        memset(bar, '#', len);
+        bar[len] = 0;
+
+        fprintf(f, "%04X %-4s %-15s  %12llu %12llu %6.2f%% %s\n",
+                addr, mnemonic(ge_mem_read(ge, addr), ge_mem_read(ge, addr + 1)), chars,
+                (unsigned long long)profile->fetches[addr],
+                (unsigned long long)profile->cycles[addr],
+                percent(profile->cycles[addr], total), bar);
+    }
+}
@@ -0,0 +1,161 @@
+/**
+ * @file  profile.h
+ * @brief Execution profiler
+ *
+ * Counts where the emulated machine spends its time: the cycles, the
+ * pulses and the host time of every state (as found in SA), and for
+ * every row of the timing charts how many times it was looked at, how
+ * many times its command was run and how many times it was rejected by
+ * its conditions.
+ *
+ * The host time is measured around every pulse with the time stamp
+ * counter where available (rdtsc), with the monotonic clock otherwise.
+ *
+ * Profiling is enabled at runtime with ge_set_profile(), and makes the
+ * machine run pulse by pulse (see insn.h).
+ *
+ * The guest profile, enabled with ge_set_guest_profile(), counts the
+ * instructions of the emulated program instead: how many times the
+ * instruction at every address was fetched, in the alpha phase, and how
+ * many cycles it took, up to the fetch of the next one (so including
+ * its beta phase and the channel cycles in between). It works with the
+ * instruction engine as well.
+ */
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "ge.h"
+#include "msl.h"
+
+/// Counters of a row of the timing charts
+struct ge_profile_row {
+    uint64_t runs;             ///< Times the row was looked at
+    uint64_t fired;            ///< Times its command was run
+    uint64_t additional_false; ///< Times it was rejected by the additional condition
+    uint64_t condition_false;  ///< Times it was rejected by the condition
+};
+
+/// Counters of a state
+struct ge_profile_state {
+    uint64_t cycles; ///< Cycles ended in the state
+    uint64_t pulses; ///< Pulses run in the state
+    uint64_t ticks;  ///< Host time spent running the pulses, see ge_profile_ticks()
+};
+
+/**
+ * Profile
+ *
+ * The rows are indexed as prepared by msl_init(), see msl_get_row().
+ */
+struct ge_profile {
+    struct ge_profile_state states[0x100];
+    struct ge_profile_row rows[MSL_MAX_ROWS];
+};
+
+/**
+ * Count an event of a row of the running state
+ *
+ * `i` is the index of the row in the rows of the state, see
+ * msl_timing_state.
+ */
+#define GE_PROFILE_ROW(ge, i, event)                \
+    do {                                            \
+        if ((ge)->profile)                          \
+            (ge)->profile_rows[i].event++;          \
+    } while (0)
+
+/// Reset all the counters
+void ge_profile_init(struct ge_profile *profile);
+
+/// Set (or reset, if NULL) the profile the machine counts into
+void ge_set_profile(struct ge *ge, struct ge_profile *profile);
+
+/**
+ * Host time
+ *
+ * The time stamp counter on x86, nanoseconds of the monotonic clock
+ * elsewhere. See ge_profile_ticks_unit().
+ */
+uint64_t ge_profile_ticks(void);
+
+/// The unit of ge_profile_ticks(), "tsc" or "ns"
+const char *ge_profile_ticks_unit(void);
+
+/**
+ * Account a pulse
+ *
+ * Called by ge_run_pulse() after every pulse, with the host time it
+ * took.
+ */
+void ge_profile_pulse(struct ge *ge, uint64_t ticks);
+
+/// Add the counters of `src` to `dst`
+void ge_profile_merge(struct ge_profile *dst, const struct ge_profile *src);
+
+/**
+ * Print a report
+ *
+ * The states sorted by cycles, the commands sorted by the times they
+ * were run and the rows sorted by the times they were looked at.
+ */
+void ge_profile_print(const struct ge_profile *profile, FILE *f);
+
+/**
+ * Write the report as JSON
+ *
+ * The same as ge_profile_print(), as an object with the "states",
+ * "commands" and "rows" arrays.
+ *
+ * @return 0 on success, -1 on write errors
+ */
+int ge_profile_write_json(const struct ge_profile *profile, FILE *f);
+
+/// No instruction fetched yet, see ge_guest_profile
+#define GE_GUEST_PROFILE_NONE MEM_SIZE
+
+/**
+ * Guest profile
+ *
+ * Counters of the instructions, indexed by the address they were
+ * fetched from.
+ */
+struct ge_guest_profile {
+    uint64_t fetches[MEM_SIZE]; ///< Times the instruction was fetched
+    uint64_t cycles[MEM_SIZE];  ///< Cycles run from its fetch to the next one
+
+    uint32_t current;  ///< Address of the instruction being run, or GE_GUEST_PROFILE_NONE
+    uint16_t cycle_po; ///< PO at the beginning of the cycle
+};
+
+/// Reset all the counters
+void ge_guest_profile_init(struct ge_guest_profile *profile);
+
+/// Set (or reset, if NULL) the guest profile the machine counts into
+void ge_set_guest_profile(struct ge *ge, struct ge_guest_profile *profile);
+
+/**
+ * Account a cycle
+ *
+ * Called by ge_run_pulse() at the beginning (`end` = 0) and at the end
+ * (`end` = 1) of every cycle.
+ */
+void ge_guest_profile_cycle(struct ge *ge, uint8_t end);
+
+/// Account a whole instruction fetched at `addr`, run by the instruction engine
+void ge_guest_profile_insn(struct ge *ge, uint16_t addr, unsigned cycles);
+
+/**
+ * Print an annotated listing
+ *
+ * One line for every instruction fetched, by address, in the style of
+ * software/loader.txt: the address, the mnemonic and the characters of
+ * the instruction as found in the memory of `ge`, followed by the
+ * fetches, the cycles, their share of all the cycles and a bar.
+ */
+void ge_guest_profile_print(const struct ge_guest_profile *profile,
+                            struct ge *ge, FILE *f);
+
+#endif /* PROFILE_H */
@@ -4,6 +4,7 @@
 #include "ge.h"
 #include "signals.h"
 #include "log.h"
+#include "mem.h"
 
 static void on_TO00(struct ge *ge) {
     /* cpu fo. 115 */
@@ -36,6 +37,7 @@ static void on_TO00(struct ge *ge) {
     /* CO41 used to set from_zero is issued in TO10, so this looks
      * like a reasonable place to reset this */
     ge->counting_network.cmds.from_zero = 0;
+    NI_changed(ge);
 }
 
 static void on_TO10(struct ge *ge) {
@@ -48,9 +50,6 @@ static void on_TO10(struct ge *ge) {
     /* TODO: a "counter" with RAMO, RAMI should count (cpu fo. 115) */
 }
 
-static void on_TO11(struct ge *ge) {}
-static void on_TO15(struct ge *ge) {}
-
 static void on_TO19(struct ge *ge) {
     /* intermediate fo. 9 B1*/
     ge->RECE = 0;
@@ -62,14 +61,13 @@ static void on_TO20(struct ge *ge) {
 
     ge->kNO.forcings = 0;
     ge->kNO.force_mode = KNOT_FORCING_NONE;
+    NO_changed(ge);
 
     ge->ACIC = 0; /* cpu fo. 99  */
     ge->rRO = 0;  /* cpu fo. 142 */
+    NI_changed(ge);
 }
 
-static void on_TO25(struct ge *ge) {}
-static void on_TO30(struct ge *ge) {}
-
 static void on_TO40(struct ge *ge) {
     /* stub */
     if (ge->counting_network.cmds.from_zero) {
@@ -77,6 +75,7 @@ static void on_TO40(struct ge *ge) {
         ge->kNI.ni2 = NS_CN2;
         ge->kNI.ni3 = NS_CN3;
         ge->kNI.ni4 = NS_CN4;
+        NI_changed(ge);
     }
 }
 
@@ -86,7 +85,8 @@ static void on_TO50(struct ge *ge) {
      * it didn't work to implement the state CC for PERI.
      * reading here  seems to work in all known cases */
     if (ge->memory_command == MC_READ) {
-        ge->rRO = ge->mem[ge->rVO];
+        ge->rRO = ge_mem_read(ge, ge->rVO);
+        NI_changed(ge);
         ge_log(LOG_STATES, "memory read: RO = mem[VO] = mem[%x] = %x\n", ge->rVO, ge->rRO);
 
         ge->memory_command = MC_NONE;
@@ -98,24 +98,23 @@ static void on_TO50_1(struct ge *ge) {
         /* timing chart js1-js2-jie-ecc, fo. 32,
          * also, display, fo. 17 */
         ge->rBO = NO_knot(ge);
+        NI_changed(ge);
     }
 
     ge->TO50_did_CI32_or_CI33 = 0;
 
     ge->kNO.forcings = 0;
     ge->kNO.force_mode = KNOT_FORCING_NONE;
+    NO_changed(ge);
 }
 
-static void on_TO60(struct ge *ge) {}
-static void on_TO64(struct ge *ge) {}
-
 static void on_TO65(struct ge *ge) {
     /* not sure about the timing of memory ops
      * in cpu fo. 145, "write" seems to be at around TO65,
      * and the "test k" fails if it's in TO50. */
 
     if (ge->memory_command == MC_WRITE) {
-        ge->mem[ge->rVO] = ge->rRO;
+        ge_mem_write(ge, ge->rVO, ge->rRO);
         ge_log(LOG_STATES, "memory write: mem[VO] = RO = mem[%x] = %x\n", ge->rVO, ge->rRO);
 
         ge->memory_command = MC_NONE;
@@ -124,6 +123,7 @@ static void on_TO65(struct ge *ge) {
     /* "enables the second phase commands for count selection"
      * (cpu fo. 142), not sure this is what it means */
     ge->counting_network.cmds.from_zero = 0;
+    NI_changed(ge);
 }
 
 static void on_TO70(struct ge *ge) {
@@ -131,8 +131,6 @@ static void on_TO70(struct ge *ge) {
         ge->RASI = 0;
 }
 
-static void on_TO80(struct ge *ge) {}
-
 static void on_TO89(struct ge *ge) {
     ge->PEC1 = 0;
 }
@@ -149,31 +147,30 @@ static void on_TI05(struct ge *ge) {
         ge->ACIC = 1;  /* cpu fo. 99 */
 }
 
-static void on_TI06(struct ge *ge) {}
-static void on_TI10(struct ge *ge) {}
-
+/* NULL for the pulses without common logic, these can be skipped by
+ * ge_run_cycle() */
 static on_pulse_cb pulse_cb[END_OF_STATUS] = {
     on_TO00,
     on_TO10,
-    on_TO11,
-    on_TO15,
+    NULL,       /* TO11 */
+    NULL,       /* TO15 */
     on_TO19,
     on_TO20,
-    on_TO25,
-    on_TO30,
+    NULL,       /* TO25 */
+    NULL,       /* TO30 */
     on_TO40,
     on_TO50,
     on_TO50_1,
-    on_TO60,
-    on_TO64,
+    NULL,       /* TO60 */
+    NULL,       /* TO64 */
     on_TO65,
     on_TO70,
-    on_TO80,
+    NULL,       /* TO80 */
     on_TO89,
     on_TO90,
     on_TI05,
-    on_TI06,
-    on_TI10,
+    NULL,       /* TI06 */
+    NULL,       /* TI10 */
 };
 
 
@@ -183,3 +180,16 @@ void pulse(struct ge *ge)
         pulse_cb[ge->current_clock](ge);
     }
 }
+
+uint32_t pulse_active_clocks(void)
+{
+    uint32_t mask = 0;
+    int c;
+
+    for (c = 0; c < END_OF_STATUS; c++) {
+        if (pulse_cb[c])
+            mask |= 1 << c;
+    }
+
+    return mask;
+}
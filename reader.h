@@ -5,6 +5,32 @@
 
 struct ge;
 
+/**
+ * Commands of the integrated reader, as found in RE when the
+ * peripheral is selected: X(code, name, description)
+ */
+#define ENUMERATE_READER_COMMANDS \
+    X(0x40, read,          "Read unchanged") \
+    X(0x21, read_normal_1, "Read normal i" ) \
+    X(0x01, read_normal_2, "Read normal ii") \
+    X(0x24, read_mixed_1,  "Read mixed i"  ) \
+    X(0x04, read_mixed_2,  "Read mixed ii" ) \
+    X(0x20, read_binary,   "Read binary"   ) \
+    X(0xa1, put_normal_1,  "Put normal i"  ) \
+    X(0x81, put_normal_2,  "Put normal ii" ) \
+    X(0xa4, put_mixed_1,   "Put mixed i"   ) \
+    X(0x84, put_mixed_2,   "Put mixed ii"  ) \
+    X(0xa0, put_binary,    "Put binary"    ) \
+    X(0xac, put_manual,    "Put manual"    ) \
+    X(0x48, card_reject,   "Card_reject"   ) \
+    X(0x0c, no_function,   "No function"   )
+
+enum reader_command {
+#define X(cmd, name, desc) READER_##name = cmd,
+    ENUMERATE_READER_COMMANDS
+#undef X
+};
+
 struct ge_integrated_reader {
     uint8_t lu08:1;
     uint8_t fini:1;
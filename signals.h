@@ -141,6 +141,31 @@ SIG(AF52) { return ge->register_selector == RS_FI_UR;   }
 SIG(AF53) { return ge->register_selector == RS_FO;      }
 /** @} */
 
+/**
+ * @defgroup knot-cache Knot invalidation
+ *
+ * The core calls these after changing a register or selector driving
+ * the NO or NI knots. Code changing them from outside the core, such as
+ * the peripherals, the snapshots, the console or the tests, must call
+ * them too, or knots_changed() when it is not worth telling which.
+ *
+ * @{
+ */
+
+/** NO must be recomputed: kNO, PO, V1-V4, L1-L3, RI or AM changed */
+static inline void NO_changed(struct ge *ge) { ge->knots.no_valid = 0; }
+
+/** NI must be recomputed: kNI, RO, BO or the counting network changed */
+static inline void NI_changed(struct ge *ge) { ge->knots.ni_valid = 0; }
+
+static inline void knots_changed(struct ge *ge)
+{
+    NO_changed(ge);
+    NI_changed(ge);
+}
+
+/** @} */
+
 static inline uint16_t ge_counting_network_output(struct ge *ge) {
     if (ge->counting_network.cmds.from_zero) {
         return ge->rBO + 1;
@@ -166,6 +191,9 @@ static inline uint16_t NO_knot(struct ge *ge)
 {
     uint16_t no = 0;
 
+    if (ge->knots.no_valid)
+        return ge->knots.no;
+
     switch (ge->kNO.cmd) {
         case KNOT_PO_IN_NO:       no = ge->rPO; break;
         case KNOT_V1_IN_NO:       no = ge->rV1; break;
@@ -185,6 +213,8 @@ static inline uint16_t NO_knot(struct ge *ge)
         case KNOT_FORCING_NO_43: no = (no & 0xff00) | (ge->kNO.forcings << 8); break;
     }
 
+    ge->knots.no = no;
+    ge->knots.no_valid = 1;
     return no;
 }
 
@@ -224,9 +254,7 @@ static inline uint8_t NA_knot(struct ge *ge) {
     return na;
 }
 
-static inline uint8_t NI_source(struct ge *ge, enum knot_ni_source source) {
-    uint16_t cn = ge_counting_network_output(ge);
-
+static inline uint8_t NI_source(struct ge *ge, uint16_t cn, enum knot_ni_source source) {
     switch (source) {
         case NS_CN1: return (cn & 0x000f) >>  0;
         case NS_CN2: return (cn & 0x00f0) >>  4;
@@ -261,15 +289,23 @@ static inline uint8_t NI_source(struct ge *ge, enum knot_ni_source source) {
  * signals generation (cpu fo. 125, 126).
  */
 static inline uint16_t NI_knot(struct ge *ge) {
-    uint16_t ni1 = NI_source(ge, ge->kNI.ni1);
-    uint16_t ni2 = NI_source(ge, ge->kNI.ni2);
-    uint16_t ni3 = NI_source(ge, ge->kNI.ni3);
-    uint16_t ni4 = NI_source(ge, ge->kNI.ni4);
-
-    return ((ni4 << 12) |
-            (ni3 <<  8) |
-            (ni2 <<  4) |
-            (ni1 <<  0));
+    uint16_t cn, ni1, ni2, ni3, ni4;
+
+    if (ge->knots.ni_valid)
+        return ge->knots.ni;
+
+    cn  = ge_counting_network_output(ge);
+    ni1 = NI_source(ge, cn, ge->kNI.ni1);
+    ni2 = NI_source(ge, cn, ge->kNI.ni2);
+    ni3 = NI_source(ge, cn, ge->kNI.ni3);
+    ni4 = NI_source(ge, cn, ge->kNI.ni4);
+
+    ge->knots.ni = ((ni4 << 12) |
+                    (ni3 <<  8) |
+                    (ni2 <<  4) |
+                    (ni1 <<  0));
+    ge->knots.ni_valid = 1;
+    return ge->knots.ni;
 }
 
 /** @} */
@@ -0,0 +1,406 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "snapshot.h"
+#include "ge.h"
+#include "log.h"
+#include "mem.h"
+#include "signals.h"
+
+/* Fields of the "CONS" section */
+#define ENUMERATE_CONSOLE_FIELDS \
+    X8(register_selector)        \
+    X8(console_switches.PAPA)    \
+    X8(console_switches.PATE)    \
+    X8(console_switches.RICI)    \
+    X8(console_switches.ACOV)    \
+    X8(console_switches.ACON)    \
+    X8(console_switches.INAR)    \
+    X8(console_switches.STOC)    \
+    X8(console_switches.INCE)    \
+    X8(console_switches.SITE)    \
+    X8(console_switches.lamps_on) \
+    X16(console_switches.AM)
+
+/* Fields of the "RDR " section */
+#define ENUMERATE_READER_FIELDS   \
+    X8(integrated_reader.lu08)    \
+    X8(integrated_reader.fini)    \
+    X8(integrated_reader.data)
+
+/* Fields of the "ST3 " and "ST4 " sections */
+#define ENUMERATE_CONNECTOR_FIELDS \
+    X8(data)                       \
+    X8(mare)                       \
+    X8(te10)                       \
+    X8(te20)                       \
+    X8(te30)                       \
+    X8(fine)
+
+struct reader {
+    const uint8_t *data;
+    size_t size;
+    size_t pos;
+    int error;
+};
+
+int ge_snapshot_put(struct ge_snapshot_buf *buf, const void *data, size_t size)
+{
+    if (buf->size + size > buf->allocated) {
+        size_t allocated = buf->allocated ? buf->allocated : 0x100;
+        uint8_t *p;
+
+        while (buf->size + size > allocated)
+            allocated *= 2;
+
+        p = realloc(buf->data, allocated);
+        if (p == NULL)
+            return -1;
+
+        buf->data = p;
+        buf->allocated = allocated;
+    }
+
+    memcpy(buf->data + buf->size, data, size);
+    buf->size += size;
+    return 0;
+}
+
+static int put_u8(struct ge_snapshot_buf *buf, uint8_t v)
+{
+    return ge_snapshot_put(buf, &v, 1);
+}
+
+static int put_u16(struct ge_snapshot_buf *buf, uint16_t v)
+{
+    uint8_t b[2] = { v & 0xff, v >> 8 };
+    return ge_snapshot_put(buf, b, sizeof(b));
+}
+
+static int put_u32(struct ge_snapshot_buf *buf, uint32_t v)
+{
+    uint8_t b[4] = { v & 0xff, (v >> 8) & 0xff, (v >> 16) & 0xff, v >> 24 };
+    return ge_snapshot_put(buf, b, sizeof(b));
+}
+
+static uint8_t get_u8(struct reader *r)
+{
+    if (r->pos + 1 > r->size) {
+        r->error = 1;
+        return 0;
+    }
+
+    return r->data[r->pos++];
+}
+
+static uint16_t get_u16(struct reader *r)
+{
+    uint16_t v = get_u8(r);
+    return v | (get_u8(r) << 8);
+}
+
+static uint32_t get_u32(struct reader *r)
+{
+    uint32_t v = get_u16(r);
+    return v | ((uint32_t)get_u16(r) << 16);
+}
+
+static int write_section(FILE *file, const char *tag, struct ge_snapshot_buf *payload)
+{
+    struct ge_snapshot_buf header = { 0 };
+    int r = 0;
+
+    r |= ge_snapshot_put(&header, tag, 4);
+    r |= put_u32(&header, payload->size);
+
+    if (r == 0 && fwrite(header.data, header.size, 1, file) != 1)
+        r = -1;
+
+    if (r == 0 && payload->size && fwrite(payload->data, payload->size, 1, file) != 1)
+        r = -1;
+
+    free(header.data);
+    payload->size = 0;
+    return r;
+}
+
+static void save_cpu(struct ge *ge, struct ge_snapshot_buf *buf, int *r)
+{
+#define X8(f)  *r |= put_u8(buf, ge->f);
+#define X16(f) *r |= put_u16(buf, ge->f);
+    ENUMERATE_CPU_FIELDS
+#undef X8
+#undef X16
+}
+
+static void load_cpu(struct ge *ge, struct reader *rd)
+{
+#define X8(f)  ge->f = get_u8(rd);
+#define X16(f) ge->f = get_u16(rd);
+    ENUMERATE_CPU_FIELDS
+#undef X8
+#undef X16
+}
+
+static void save_console(struct ge *ge, struct ge_snapshot_buf *buf, int *r)
+{
+#define X8(f)  *r |= put_u8(buf, ge->f);
+#define X16(f) *r |= put_u16(buf, ge->f);
+    ENUMERATE_CONSOLE_FIELDS
+#undef X8
+#undef X16
+}
+
+static void load_console(struct ge *ge, struct reader *rd)
+{
+#define X8(f)  ge->f = get_u8(rd);
+#define X16(f) ge->f = get_u16(rd);
+    ENUMERATE_CONSOLE_FIELDS
+#undef X8
+#undef X16
+}
+
+static void save_reader(struct ge *ge, struct ge_snapshot_buf *buf, int *r)
+{
+#define X8(f)  *r |= put_u8(buf, ge->f);
+    ENUMERATE_READER_FIELDS
+#undef X8
+}
+
+static void load_reader(struct ge *ge, struct reader *rd)
+{
+#define X8(f)  ge->f = get_u8(rd);
+    ENUMERATE_READER_FIELDS
+#undef X8
+}
+
+static void save_connector(struct ge_connector *conn, struct ge_snapshot_buf *buf, int *r)
+{
+#define X8(f)  *r |= put_u8(buf, conn->f);
+    ENUMERATE_CONNECTOR_FIELDS
+#undef X8
+}
+
+static void load_connector(struct ge_connector *conn, struct reader *rd)
+{
+#define X8(f)  conn->f = get_u8(rd);
+    ENUMERATE_CONNECTOR_FIELDS
+#undef X8
+}
+
+static uint8_t page_is_empty(const uint8_t *page)
+{
+    int i;
+
+    for (i = 0; i < MEM_PAGE_SIZE; i++) {
+        if (page[i])
+            return 0;
+    }
+
+    return 1;
+}
+
+/* only the pages which are not all zeros are stored */
+static void save_memory(struct ge *ge, struct ge_snapshot_buf *buf, int *r)
+{
+    uint16_t pages = 0;
+    int i;
+
+    for (i = 0; i < MEM_PAGES; i++)
+        pages += !page_is_empty(ge_mem_page_data(ge, i));
+
+    *r |= put_u16(buf, pages);
+
+    for (i = 0; i < MEM_PAGES; i++) {
+        if (page_is_empty(ge_mem_page_data(ge, i)))
+            continue;
+
+        *r |= put_u8(buf, i);
+        *r |= ge_snapshot_put(buf, ge_mem_page_data(ge, i), MEM_PAGE_SIZE);
+    }
+}
+
+static void load_memory(struct ge *ge, struct reader *rd)
+{
+    uint16_t pages = get_u16(rd);
+    uint8_t page;
+
+    ge_mem_clear(ge);
+
+    while (pages-- && !rd->error) {
+        page = get_u8(rd);
+
+        if (rd->pos + MEM_PAGE_SIZE > rd->size ||
+            ge_mem_load(ge, page * MEM_PAGE_SIZE, rd->data + rd->pos, MEM_PAGE_SIZE) != 0) {
+            rd->error = 1;
+            break;
+        }
+
+        rd->pos += MEM_PAGE_SIZE;
+    }
+}
+
+int ge_snapshot_register_section(struct ge *ge, struct ge_snapshot_section *s)
+{
+    struct ge_snapshot_section **prec_next = &ge->snapshot_sections;
+
+    while (*prec_next != NULL) {
+        if (strcmp((*prec_next)->name, s->name) == 0)
+            return -1;
+
+        prec_next = &(*prec_next)->next;
+    }
+
+    *prec_next = s;
+    s->next = NULL;
+    return 0;
+}
+
+int ge_snapshot_save(struct ge *ge, FILE *file)
+{
+    struct ge_snapshot_buf buf = { 0 };
+    struct ge_snapshot_section *s;
+    uint8_t len;
+    int r = 0;
+
+    r |= ge_snapshot_put(&buf, GE_SNAPSHOT_MAGIC, sizeof(GE_SNAPSHOT_MAGIC));
+    r |= ge_snapshot_put(&buf, "\0", 8 - sizeof(GE_SNAPSHOT_MAGIC));
+    r |= put_u16(&buf, GE_SNAPSHOT_VERSION);
+    r |= put_u16(&buf, 0);
+    if (r == 0 && fwrite(buf.data, buf.size, 1, file) != 1)
+        r = -1;
+    buf.size = 0;
+
+    save_cpu(ge, &buf, &r);
+    r |= write_section(file, "CPU ", &buf);
+
+    save_memory(ge, &buf, &r);
+    r |= write_section(file, "MEM ", &buf);
+
+    save_reader(ge, &buf, &r);
+    r |= write_section(file, "RDR ", &buf);
+
+    save_connector(&ge->ST3, &buf, &r);
+    r |= write_section(file, "ST3 ", &buf);
+
+    save_connector(&ge->ST4, &buf, &r);
+    r |= write_section(file, "ST4 ", &buf);
+
+    save_console(ge, &buf, &r);
+    r |= write_section(file, "CONS", &buf);
+
+    for (s = ge->snapshot_sections; s != NULL && r == 0; s = s->next) {
+        len = strlen(s->name);
+        r |= put_u8(&buf, len);
+        r |= ge_snapshot_put(&buf, s->name, len);
+
+        if (s->save)
+            r |= s->save(ge, s->ctx, &buf);
+
+        r |= write_section(file, "PERI", &buf);
+    }
+
+    free(buf.data);
+    return r ? -1 : 0;
+}
+
+static int load_peripheral(struct ge *ge, struct reader *rd)
+{
+    struct ge_snapshot_section *s;
+    uint8_t len = get_u8(rd);
+
+    if (rd->error || rd->pos + len > rd->size)
+        return -1;
+
+    for (s = ge->snapshot_sections; s != NULL; s = s->next) {
+        if (strlen(s->name) == len && memcmp(s->name, rd->data + rd->pos, len) == 0)
+            break;
+    }
+
+    if (s == NULL) {
+        ge_log(LOG_ERR, "snapshot: skipping unknown peripheral section %.*s\n",
+               len, rd->data + rd->pos);
+        return 0;
+    }
+
+    rd->pos += len;
+
+    if (s->load == NULL)
+        return 0;
+
+    return s->load(ge, s->ctx, rd->data + rd->pos, rd->size - rd->pos);
+}
+
+int ge_snapshot_load(struct ge *ge, FILE *file)
+{
+    uint8_t header[12];
+    struct reader rd = { header, sizeof(header), 0, 0 };
+    uint8_t *payload = NULL;
+    uint8_t *p;
+    char tag[4];
+    uint32_t size;
+    int r = 0;
+
+    if (fread(header, sizeof(header), 1, file) != 1)
+        return -1;
+
+    if (memcmp(header, GE_SNAPSHOT_MAGIC, sizeof(GE_SNAPSHOT_MAGIC)) != 0)
+        return -1;
+
+    rd.pos = 8;
+    if (get_u16(&rd) != GE_SNAPSHOT_VERSION)
+        return -1;
+
+    while (r == 0 && fread(header, 8, 1, file) == 1) {
+        memcpy(tag, header, 4);
+        rd.data = header;
+        rd.size = 8;
+        rd.pos = 4;
+        size = get_u32(&rd);
+
+        p = realloc(payload, size ? size : 1);
+        if (p == NULL) {
+            r = -1;
+            break;
+        }
+        payload = p;
+
+        if (size && fread(payload, size, 1, file) != 1) {
+            r = -1;
+            break;
+        }
+
+        rd.data = payload;
+        rd.size = size;
+        rd.pos = 0;
+
+        if (memcmp(tag, "CPU ", 4) == 0)
+            load_cpu(ge, &rd);
+        else if (memcmp(tag, "MEM ", 4) == 0)
+            load_memory(ge, &rd);
+        else if (memcmp(tag, "RDR ", 4) == 0)
+            load_reader(ge, &rd);
+        else if (memcmp(tag, "ST3 ", 4) == 0)
+            load_connector(&ge->ST3, &rd);
+        else if (memcmp(tag, "ST4 ", 4) == 0)
+            load_connector(&ge->ST4, &rd);
+        else if (memcmp(tag, "CONS", 4) == 0)
+            load_console(ge, &rd);
+        else if (memcmp(tag, "PERI", 4) == 0)
+            r = load_peripheral(ge, &rd);
+        else
+            ge_log(LOG_ERR, "snapshot: skipping unknown section %.4s\n", tag);
+
+        if (rd.error)
+            r = -1;
+    }
+
+    if (r == 0 && ferror(file))
+        r = -1;
+
+    /* the registers driving the knots have been replaced */
+    knots_changed(ge);
+
+    free(payload);
+    return r;
+}
@@ -0,0 +1,174 @@
+/**
+ * @file  snapshot.h
+ * @brief Machine state snapshots
+ *
+ * Saves and restores the complete state of a struct ge: registers,
+ * flip flops, knots, memory, the integrated reader, the ST3 and ST4
+ * connectors and the console.
+ *
+ * A snapshot is a header followed by a list of sections, each one
+ * made of a 4 characters tag, a 32 bit length and the payload. All
+ * the values are stored little endian. Peripherals can add their own
+ * sections with ge_snapshot_register_section().
+ */
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define GE_SNAPSHOT_MAGIC   "GESNAP"
+#define GE_SNAPSHOT_VERSION 1
+
+/*
+ * The fields of struct ge stored in the "CPU " section, in order.
+ *
+ * Fields added to struct ge should be added here too, at the end of
+ * the list, bumping GE_SNAPSHOT_VERSION. The list is also used by the
+ * lockstep checker to compare two machines.
+ */
+#define ENUMERATE_CPU_FIELDS \
+    X8(current_clock)                   \
+    X8(halted)                          \
+    X8(powered)                         \
+    X16(rPO)                            \
+    X16(rV1)                            \
+    X16(rV2)                            \
+    X16(rV3)                            \
+    X16(rV4)                            \
+    X8(rRI)                             \
+    X16(rL1)                            \
+    X8(rL2)                             \
+    X16(rL3)                            \
+    X8(kNO.forcings)                    \
+    X8(kNO.force_mode)                  \
+    X8(kNO.cmd)                         \
+    X8(kNI.ni1)                         \
+    X8(kNI.ni2)                         \
+    X8(kNI.ni3)                         \
+    X8(kNI.ni4)                         \
+    X16(rRO)                            \
+    X16(rVO)                            \
+    X16(rBO)                            \
+    X8(rFO)                             \
+    X8(rSO)                             \
+    X8(rSI)                             \
+    X8(rSA)                             \
+    X8(rRE)                             \
+    X8(rRA)                             \
+    X8(ffFI)                            \
+    X8(ffFA)                            \
+    X8(RETO)                            \
+    X8(RET2)                            \
+    X8(AINI)                            \
+    X8(ALOI)                            \
+    X8(ALTO)                            \
+    X8(PODI)                            \
+    X8(ACIC)                            \
+    X8(ALAM)                            \
+    X8(AVER)                            \
+    X8(ADIR)                            \
+    X8(RINT)                            \
+    X8(JS1)                             \
+    X8(JS2)                             \
+    X8(JE)                              \
+    X8(INTE)                            \
+    X8(PB06)                            \
+    X8(PB07)                            \
+    X8(PB26)                            \
+    X8(PB36)                            \
+    X8(PB37)                            \
+    X8(PIC1)                            \
+    X8(RASI)                            \
+    X8(PUC2)                            \
+    X8(PUC3)                            \
+    X8(PEC1)                            \
+    X8(RUF1)                            \
+    X8(URPE)                            \
+    X8(URPU)                            \
+    X8(RC00)                            \
+    X8(RC01)                            \
+    X8(RC02)                            \
+    X8(RC03)                            \
+    X8(RIA0)                            \
+    X8(RESI)                            \
+    X8(RIA2)                            \
+    X8(RIA3)                            \
+    X8(RECE)                            \
+    X8(RIG1)                            \
+    X8(RIG3)                            \
+    X8(RACI)                            \
+    X8(RAVI)                            \
+    X8(RT121)                           \
+    X8(RT131)                           \
+    X8(future_state)                    \
+    X8(step_by_step)                    \
+    X8(memory_command)                  \
+    X8(counting_network.cmds.from_zero) \
+    X8(counting_network.cmds.decresing) \
+    X8(TO50_did_CI32_or_CI33)
+
+struct ge;
+
+/**
+ * Snapshot buffer
+ *
+ * A growing buffer the payload of a section is written into.
+ */
+struct ge_snapshot_buf {
+    uint8_t *data;
+    size_t size;
+    size_t allocated;
+};
+
+/**
+ * Peripheral snapshot section
+ *
+ * Allows a peripheral to store its own state in a snapshot. The section
+ * is identified by `name`, which must be unique among the sections
+ * registered to the same machine.
+ */
+struct ge_snapshot_section {
+    struct ge_snapshot_section *next;
+    const char *name;
+
+    /// Write the state of the peripheral in `buf`
+    int (*save)(struct ge *, void *ctx, struct ge_snapshot_buf *buf);
+
+    /// Restore the state of the peripheral from `data`
+    int (*load)(struct ge *, void *ctx, const uint8_t *data, size_t size);
+
+    void *ctx;
+};
+
+/// Register a peripheral section, to be saved and loaded with the machine
+int ge_snapshot_register_section(struct ge *ge, struct ge_snapshot_section *s);
+
+/// Append data to a snapshot buffer, returns 0 on success
+int ge_snapshot_put(struct ge_snapshot_buf *buf, const void *data, size_t size);
+
+/**
+ * Save a snapshot
+ *
+ * @param ge   the machine to save
+ * @param file where to write the snapshot
+ * @return 0 on success, -1 on errors
+ */
+int ge_snapshot_save(struct ge *ge, FILE *file);
+
+/**
+ * Load a snapshot
+ *
+ * The machine should have been initialized, and the peripherals whose
+ * sections are in the snapshot registered. Sections of peripherals
+ * which are not registered are skipped.
+ *
+ * @param ge   the machine to restore
+ * @param file the snapshot to read
+ * @return 0 on success, -1 on errors
+ */
+int ge_snapshot_load(struct ge *ge, FILE *file);
+
+#endif /* SNAPSHOT_H */
@@ -0,0 +1,214 @@
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "utest.h"
+#include "../ge.h"
+#include "../console_socket.h"
+
+static char server_path[64];
+
+static const char *server_open(struct ge *g)
+{
+    snprintf(server_path, sizeof(server_path), "/tmp/ge-console-test.%d", getpid());
+    return console_socket_register(g, server_path) == 0 ? server_path : NULL;
+}
+
+static int client_open(struct sockaddr_un *addr, int n)
+{
+    struct sockaddr_un server = { .sun_family = AF_UNIX };
+    struct timeval tv = { .tv_usec = 100000 };
+    int fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+
+    if (fd < 0)
+        return -1;
+
+    memset(addr, 0, sizeof(*addr));
+    addr->sun_family = AF_UNIX;
+    snprintf(addr->sun_path, sizeof(addr->sun_path), "%s.client.%d", server_path, n);
+    unlink(addr->sun_path);
+
+    strcpy(server.sun_path, server_path);
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    if (bind(fd, (struct sockaddr *)addr, sizeof(*addr)) != 0 ||
+        connect(fd, (struct sockaddr *)&server, sizeof(server)) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+static int client_send(int fd, enum console_msg_type type, const void *payload, size_t size)
+{
+    uint8_t buf[64];
+    struct console_msg msg = { .version = CONSOLE_PROTOCOL_VERSION, .type = type };
+
+    memcpy(buf, &msg, sizeof(msg));
+    if (size)
+        memcpy(buf + sizeof(msg), payload, size);
+
+    return send(fd, buf, sizeof(msg) + size, 0) == (ssize_t)(sizeof(msg) + size) ? 0 : -1;
+}
+
+/* Wait for an update, running the machine, and apply it to `words` */
+static int client_update(int fd, struct ge *g, uint16_t *words, uint16_t *seq, uint16_t *mask)
+{
+    uint8_t buf[64];
+    struct console_msg msg;
+    ssize_t size = -1;
+    size_t pos;
+    int i, tries;
+
+    for (tries = 0; tries < 20 && size < 0; tries++) {
+        for (i = 0; i < 100; i++)
+            ge_run_cycle(g);
+        size = recv(fd, buf, sizeof(buf), 0);
+    }
+
+    if (size < (ssize_t)(sizeof(msg) + sizeof(*mask)))
+        return -1;
+
+    memcpy(&msg, buf, sizeof(msg));
+    memcpy(mask, buf + sizeof(msg), sizeof(*mask));
+    if (msg.version != CONSOLE_PROTOCOL_VERSION || msg.type != CONSOLE_MSG_UPDATE)
+        return -1;
+
+    *seq = msg.seq;
+    pos = sizeof(msg) + sizeof(*mask);
+    for (i = 0; i < CONSOLE_STATE_WORDS; i++) {
+        if (!(*mask & (1 << i)))
+            continue;
+        if (pos + sizeof(words[i]) > (size_t)size)
+            return -1;
+        memcpy(&words[i], buf + pos, sizeof(words[i]));
+        pos += sizeof(words[i]);
+    }
+
+    return pos == (size_t)size ? 0 : -1;
+}
+
+UTEST(console, subscribe)
+{
+    struct ge_console_switches switches = { .INAR = 1, .AM = 0x1234 };
+    struct sockaddr_un addr;
+    uint16_t words[CONSOLE_STATE_WORDS] = { 0 };
+    uint16_t interval = CONSOLE_INTERVAL_MIN, rotary = RS_SO, seq, mask;
+    struct ge g;
+    int fd;
+
+    ge_init(&g);
+    ASSERT_TRUE(server_open(&g) != NULL);
+
+    fd = client_open(&addr, 0);
+    ASSERT_TRUE(fd >= 0);
+
+    /* the first update carries all the words */
+    ASSERT_EQ(client_send(fd, CONSOLE_MSG_SUBSCRIBE, &interval, sizeof(interval)), 0);
+    ASSERT_EQ(client_update(fd, &g, words, &seq, &mask), 0);
+    ASSERT_EQ(seq, 0);
+    ASSERT_EQ(mask, (1 << CONSOLE_STATE_WORDS) - 1);
+
+    /* the commands change the machine, the updates only the words changed */
+    ASSERT_EQ(client_send(fd, CONSOLE_MSG_SWITCHES, &switches, sizeof(switches)), 0);
+    ASSERT_EQ(client_send(fd, CONSOLE_MSG_ROTARY, &rotary, sizeof(rotary)), 0);
+
+    do {
+        ASSERT_EQ(client_update(fd, &g, words, &seq, &mask), 0);
+    } while (words[CONSOLE_STATE_ROTARY] != RS_SO);
+
+    ASSERT_TRUE(seq > 0);
+    ASSERT_EQ(g.register_selector, RS_SO);
+    ASSERT_EQ(g.console_switches.INAR, 1);
+    ASSERT_EQ(g.console_switches.AM, 0x1234);
+    ASSERT_EQ(memcmp(&words[CONSOLE_STATE_SWITCHES], &switches, sizeof(switches)), 0);
+
+    ASSERT_EQ(client_send(fd, CONSOLE_MSG_UNSUBSCRIBE, NULL, 0), 0);
+
+    close(fd);
+    unlink(addr.sun_path);
+    ge_deinit(&g);
+
+    /* the socket is removed with the machine */
+    ASSERT_NE(access(server_path, F_OK), 0);
+}
+
+UTEST(console, clients)
+{
+    struct sockaddr_un addr[2];
+    uint16_t words[2][CONSOLE_STATE_WORDS] = { { 0 } };
+    uint16_t interval[2] = { CONSOLE_INTERVAL_MIN, 1000 }, seq, mask;
+    uint8_t buf[64];
+    struct ge_console_switches switches;
+    struct ge g;
+    int fd[2], i;
+
+    ge_init(&g);
+    ASSERT_TRUE(server_open(&g) != NULL);
+
+    for (i = 0; i < 2; i++) {
+        fd[i] = client_open(&addr[i], i);
+        ASSERT_TRUE(fd[i] >= 0);
+        ASSERT_EQ(client_send(fd[i], CONSOLE_MSG_SUBSCRIBE, &interval[i], sizeof(interval[i])), 0);
+    }
+
+    /* every console gets all the words first */
+    for (i = 0; i < 2; i++) {
+        ASSERT_EQ(client_update(fd[i], &g, words[i], &seq, &mask), 0);
+        ASSERT_EQ(seq, 0);
+        ASSERT_EQ(mask, (1 << CONSOLE_STATE_WORDS) - 1);
+    }
+
+    /* a change reaches the fast console, the slow one is not due yet */
+    switches = g.console_switches;
+    switches.AM ^= 0xffff;
+    ge_set_console_switches(&g, &switches);
+    ASSERT_EQ(client_update(fd[0], &g, words[0], &seq, &mask), 0);
+    ASSERT_EQ(seq, 1);
+    ASSERT_TRUE(mask & (1 << (CONSOLE_STATE_SWITCHES + 1)));
+    ASSERT_EQ(recv(fd[1], buf, sizeof(buf), MSG_DONTWAIT), -1);
+
+    for (i = 0; i < 2; i++) {
+        close(fd[i]);
+        unlink(addr[i].sun_path);
+    }
+    ge_deinit(&g);
+}
+
+UTEST(console, path)
+{
+    struct sockaddr_un addr, stale = { .sun_family = AF_UNIX };
+    uint16_t words[CONSOLE_STATE_WORDS] = { 0 }, seq, mask;
+    struct ge g, other;
+    int fd;
+
+    /* left by a machine that did not stop */
+    snprintf(stale.sun_path, sizeof(stale.sun_path), "/tmp/ge-console-test.%d", getpid());
+    fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+    ASSERT_TRUE(fd >= 0);
+    ASSERT_EQ(bind(fd, (struct sockaddr *)&stale, sizeof(stale)), 0);
+    close(fd);
+
+    ge_init(&g);
+    ASSERT_TRUE(server_open(&g) != NULL);
+
+    /* a second machine cannot take the socket, nor remove it */
+    ge_init(&other);
+    ASSERT_EQ(console_socket_register(&other, server_path), -1);
+    ge_deinit(&other);
+    ASSERT_EQ(access(server_path, F_OK), 0);
+
+    fd = client_open(&addr, 0);
+    ASSERT_TRUE(fd >= 0);
+    ASSERT_EQ(client_send(fd, CONSOLE_MSG_SUBSCRIBE, NULL, 0), 0);
+    ASSERT_EQ(client_update(fd, &g, words, &seq, &mask), 0);
+
+    close(fd);
+    unlink(addr.sun_path);
+    ge_deinit(&g);
+    ASSERT_EQ(access(server_path, F_OK), -1);
+}
@@ -1,6 +1,8 @@
 #include "utest.h"
 #include "../ge.h"
 #include "../log.h"
+#include "../msl.h"
+#include "../msl-timings.h"
 
 /** diag fo. 82 */
 UTEST(cpu_isolation, test_k)
@@ -69,3 +71,104 @@ UTEST(cpu_isolation, test_k)
     ASSERT_TRUE(c.lamps.MEM_CHECK == 0);
 }
 
+
+/* ge_run_cycle skips the idle pulses, check it ends up where stepping
+ * every pulse does */
+UTEST(cpu, run_cycle_same_as_pulses)
+{
+    uint8_t mem[6] = {NOP2_OPCODE, 0xAA, NOP2_OPCODE, 0xBB, HLT_OPCODE, 0xAA};
+    struct ge g1, g2;
+    int i;
+
+    ge_init(&g1);
+    ge_clear(&g1);
+    ge_load_program(&g1, mem, sizeof(mem));
+    ge_start(&g1);
+
+    ge_init(&g2);
+    ge_clear(&g2);
+    ge_load_program(&g2, mem, sizeof(mem));
+    ge_start(&g2);
+
+    for (i = 0; i < 12; i++) {
+        ASSERT_EQ(ge_run_cycle(&g1), 0);
+
+        do {
+            ASSERT_EQ(ge_run_pulse(&g2), 0);
+        } while (g2.current_clock != TO00);
+
+        ASSERT_EQ(g1.rSO, g2.rSO);
+        ASSERT_EQ(g1.rSA, g2.rSA);
+        ASSERT_EQ(g1.rPO, g2.rPO);
+        ASSERT_EQ(g1.rRO, g2.rRO);
+        ASSERT_EQ(g1.rBO, g2.rBO);
+        ASSERT_EQ(g1.rFO, g2.rFO);
+        ASSERT_EQ(g1.rV1, g2.rV1);
+        ASSERT_EQ(g1.rL1, g2.rL1);
+        ASSERT_EQ(g1.ffFA, g2.ffFA);
+        ASSERT_EQ(g1.ffFI, g2.ffFI);
+        ASSERT_EQ(g1.ALTO, g2.ALTO);
+    }
+}
+
+UTEST(cpu, compiled_same_as_interpreted)
+{
+    uint8_t mem[6] = {NOP2_OPCODE, 0xAA, NOP2_OPCODE, 0xBB, HLT_OPCODE, 0xAA};
+    struct ge g1, g2;
+    int i;
+
+    ge_init(&g1);
+    ge_clear(&g1);
+    ge_load_program(&g1, mem, sizeof(mem));
+    ge_start(&g1);
+
+    ge_init(&g2);
+    g2.msl_interpreted = 1;
+    ge_clear(&g2);
+    ge_load_program(&g2, mem, sizeof(mem));
+    ge_start(&g2);
+
+    ASSERT_TRUE(msl_get_state(0x80)->compiled != NULL);
+
+    for (i = 0; i < 12; i++) {
+        ASSERT_EQ(ge_run_cycle(&g1), 0);
+        ASSERT_EQ(ge_run_cycle(&g2), 0);
+
+        ASSERT_EQ(g1.rSO, g2.rSO);
+        ASSERT_EQ(g1.rSA, g2.rSA);
+        ASSERT_EQ(g1.rPO, g2.rPO);
+        ASSERT_EQ(g1.rRO, g2.rRO);
+        ASSERT_EQ(g1.rBO, g2.rBO);
+        ASSERT_EQ(g1.rFO, g2.rFO);
+        ASSERT_EQ(g1.rV1, g2.rV1);
+        ASSERT_EQ(g1.rL1, g2.rL1);
+        ASSERT_EQ(g1.ffFA, g2.ffFA);
+        ASSERT_EQ(g1.ffFI, g2.ffFI);
+        ASSERT_EQ(g1.ALTO, g2.ALTO);
+    }
+}
+
+UTEST(cpu, unimplemented_state)
+{
+    uint8_t mem[2] = {NOP2_OPCODE, 0xAA};
+    struct ge g;
+
+    ge_init(&g);
+
+    ASSERT_TRUE(msl_get_state(0xff)->unimplemented);
+    ASSERT_FALSE(msl_get_state(0x64)->unimplemented);
+    ASSERT_EQ(msl_get_state(0x64), msl_get_state(0x65));
+
+    ge_clear(&g);
+    ge_load_program(&g, mem, sizeof(mem));
+    ge_start(&g);
+
+    /* display */
+    ASSERT_EQ(ge_run_cycle(&g), 0);
+
+    /* SA is loaded at TO10 */
+    g.rSO = 0xff;
+    ASSERT_EQ(ge_run_cycle(&g), 1);
+    ASSERT_EQ(g.rSA, 0xff);
+    ASSERT_EQ(g.current_clock, TO10);
+}
@@ -0,0 +1,244 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "utest.h"
+#include "../ge.h"
+#include "../deck.h"
+#include "../opcodes.h"
+#include "../reader.h"
+
+static uint8_t cards[2 * GE_DECK_COLUMNS + 4];
+
+static int load(struct ge *g, struct ge_deck *deck, size_t size)
+{
+    size_t i;
+    int r;
+
+    for (i = 0; i < sizeof(cards); i++)
+        cards[i] = 0x30 | (i & 0x0f);
+
+    ge_init(g);
+    ge_deck_init(deck, cards, size);
+    r = ge_deck_register(g, deck);
+
+    ge_clear(g);
+    ge_load_1(g);
+    ge_load(g);
+    ge_start(g);
+
+    return r;
+}
+
+UTEST(deck, card_length)
+{
+    ASSERT_EQ(ge_deck_card_length(READER_read), GE_DECK_COLUMNS);
+    ASSERT_EQ(ge_deck_card_length(READER_read_normal_2), GE_DECK_COLUMNS);
+    ASSERT_EQ(ge_deck_card_length(READER_read_mixed_1), GE_DECK_COLUMNS);
+    ASSERT_EQ(ge_deck_card_length(READER_read_binary), 2 * GE_DECK_COLUMNS);
+    ASSERT_EQ(ge_deck_card_length(READER_card_reject), 0);
+}
+
+UTEST(deck, initial_load)
+{
+    struct ge_deck deck;
+    struct ge g;
+    int i;
+
+    ASSERT_EQ(load(&g, &deck, sizeof(cards)), 0);
+
+    /* the initial load reads a single card, up to its FINI */
+    for (i = 0; i < 1000 && g.rSO != 0xe3; i++)
+        ASSERT_EQ(ge_run_cycle(&g), 0);
+
+    ASSERT_EQ(g.rSO, 0xe3);
+    ASSERT_EQ(deck.cards, 1);
+    ASSERT_EQ(deck.pos, GE_DECK_COLUMNS);
+    ASSERT_EQ(deck.card_end, GE_DECK_COLUMNS);
+
+    /* packed, two columns per character */
+    ASSERT_EQ(g.rV1, GE_DECK_COLUMNS / 2);
+    for (i = 0; i < GE_DECK_COLUMNS / 2; i++)
+        ASSERT_EQ(g.mem[i], ((2 * i) & 0x0f) << 4 | ((2 * i + 1) & 0x0f));
+}
+
+UTEST(deck, short_card)
+{
+    struct ge_deck deck;
+    struct ge g;
+    int i;
+
+    /* the last card ends with the deck */
+    ASSERT_EQ(load(&g, &deck, 4), 0);
+
+    for (i = 0; i < 1000 && g.rSO != 0xe3; i++)
+        ASSERT_EQ(ge_run_cycle(&g), 0);
+
+    ASSERT_EQ(g.rSO, 0xe3);
+    ASSERT_EQ(deck.pos, 4);
+    ASSERT_EQ(g.rV1, 2);
+    ASSERT_EQ(g.mem[0], 0x01);
+    ASSERT_EQ(g.mem[1], 0x23);
+}
+
+UTEST(deck, resume)
+{
+    struct ge_deck deck1, deck2;
+    struct ge g1, g2;
+    FILE *f = tmpfile();
+    int i;
+
+    ASSERT_TRUE(f != NULL);
+
+    ASSERT_EQ(load(&g1, &deck1, sizeof(cards)), 0);
+
+    /* stop in the middle of the card */
+    while (deck1.pos < 10)
+        ASSERT_EQ(ge_run_cycle(&g1), 0);
+
+    ASSERT_EQ(ge_snapshot_save(&g1, f), 0);
+    rewind(f);
+
+    ge_init(&g2);
+    ge_deck_init(&deck2, cards, sizeof(cards));
+    ASSERT_EQ(ge_deck_register(&g2, &deck2), 0);
+    ASSERT_EQ(ge_snapshot_load(&g2, f), 0);
+    fclose(f);
+
+    ASSERT_EQ(deck2.pos, deck1.pos);
+    ASSERT_EQ(deck2.card_end, GE_DECK_COLUMNS);
+    ASSERT_EQ(deck2.cards, 1);
+
+    for (i = 0; i < 1000 && g2.rSO != 0xe3; i++) {
+        ASSERT_EQ(ge_run_cycle(&g1), 0);
+        ASSERT_EQ(ge_run_cycle(&g2), 0);
+    }
+
+    ASSERT_EQ(g2.rSO, 0xe3);
+    ASSERT_EQ(g1.rSO, 0xe3);
+    ASSERT_EQ(deck2.pos, GE_DECK_COLUMNS);
+    ASSERT_EQ(memcmp(g1.mem, g2.mem, GE_DECK_COLUMNS / 2), 0);
+}
+
+UTEST(deck, open)
+{
+    char path[] = "/tmp/ge-deck-XXXXXX";
+    struct ge_deck deck;
+    struct ge g;
+    int fd = mkstemp(path);
+    int i;
+
+    ASSERT_TRUE(fd >= 0);
+    for (i = 0; i < (int)sizeof(cards); i++)
+        cards[i] = 0x30 | (i & 0x0f);
+    ASSERT_EQ(write(fd, cards, sizeof(cards)), (ssize_t)sizeof(cards));
+    close(fd);
+
+    ASSERT_EQ(ge_deck_open(&deck, path), 0);
+    unlink(path);
+    ASSERT_EQ(deck.size, sizeof(cards));
+    ASSERT_EQ(deck.mapped, sizeof(cards));
+
+    ge_init(&g);
+    ASSERT_EQ(ge_deck_register(&g, &deck), 0);
+    ge_clear(&g);
+    ge_load_1(&g);
+    ge_load(&g);
+    ge_start(&g);
+
+    for (i = 0; i < 1000 && g.rSO != 0xe3; i++)
+        ASSERT_EQ(ge_run_cycle(&g), 0);
+
+    ASSERT_EQ(g.rSO, 0xe3);
+    ASSERT_EQ(deck.pos, GE_DECK_COLUMNS);
+    ASSERT_EQ(g.rV1, GE_DECK_COLUMNS / 2);
+    ASSERT_EQ(g.mem[0], 0x01);
+    ASSERT_EQ(g.mem[GE_DECK_COLUMNS / 2 - 1], 0xef);
+
+    ge_deinit(&g);
+    ge_deck_close(&deck);
+    ASSERT_TRUE(deck.data == NULL);
+    ASSERT_EQ(deck.mapped, 0);
+}
+
+UTEST(deck, open_empty)
+{
+    char path[] = "/tmp/ge-deck-XXXXXX";
+    struct ge_deck deck;
+    struct ge g;
+    int fd = mkstemp(path);
+    int i;
+
+    ASSERT_TRUE(fd >= 0);
+    close(fd);
+
+    /* nothing mapped, and nothing fed */
+    ASSERT_EQ(ge_deck_open(&deck, path), 0);
+    unlink(path);
+    ASSERT_EQ(deck.size, 0);
+    ASSERT_EQ(deck.mapped, 0);
+
+    ge_init(&g);
+    ASSERT_EQ(ge_deck_register(&g, &deck), 0);
+    ge_clear(&g);
+    ge_load_1(&g);
+    ge_load(&g);
+    ge_start(&g);
+
+    for (i = 0; i < 100; i++)
+        ASSERT_EQ(ge_run_cycle(&g), 0);
+
+    ASSERT_EQ(g.rSO, 0xb8);
+    ASSERT_EQ(deck.cards, 0);
+
+    ge_deinit(&g);
+    ge_deck_close(&deck);
+
+    ASSERT_EQ(ge_deck_open(&deck, path), -1);
+}
+
+UTEST(deck, binary)
+{
+    struct ge_deck deck;
+    struct ge g;
+    int i;
+
+    for (i = 0; i < (int)sizeof(cards); i++)
+        cards[i] = i & 0x3f;
+
+    ge_init(&g);
+    ge_deck_init(&deck, cards, sizeof(cards));
+    ASSERT_EQ(ge_deck_register(&g, &deck), 0);
+
+    /* PER to the integrated reader, read binary to 0x100, then HLT */
+    g.mem[0x00] = PER_OPCODE;
+    g.mem[0x01] = 0x80;
+    g.mem[0x02] = 0x00;
+    g.mem[0x03] = 0x10;
+    g.mem[0x04] = HLT_OPCODE;
+    g.mem[0x05] = 0x00;
+
+    g.mem[0x10] = 0x00;
+    g.mem[0x11] = READER_read_binary;
+    g.mem[0x12] = 0x00;
+    g.mem[0x13] = 2 * GE_DECK_COLUMNS - 1;
+    g.mem[0x14] = 0x01;
+    g.mem[0x15] = 0x00;
+
+    ge_clear(&g);
+    ge_start(&g);
+
+    for (i = 0; i < 1000 && !g.ALTO; i++)
+        ASSERT_EQ(ge_run_cycle(&g), 0);
+
+    /* a card of two characters per column, packed */
+    ASSERT_TRUE(g.ALTO);
+    ASSERT_EQ(deck.cards, 1);
+    ASSERT_EQ(deck.pos, 2 * GE_DECK_COLUMNS);
+    ASSERT_EQ(g.rV1, 0x100 + GE_DECK_COLUMNS);
+    for (i = 0; i < GE_DECK_COLUMNS; i++)
+        ASSERT_EQ(g.mem[0x100 + i], ((2 * i) & 0x0f) << 4 | ((2 * i + 1) & 0x0f));
+
+    ge_deinit(&g);
+}
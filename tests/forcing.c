@@ -1,5 +1,6 @@
 #include "utest.h"
 #include "../ge.h"
+#include "../signals.h"
 
 UTEST(display, show_registers)
 {
@@ -16,6 +17,7 @@ UTEST(display, show_registers)
     g.rL1 = 0x1111;
     g.rL2 = 0x22;
     g.rL3 = 0x3333;
+    knots_changed(&g);
 
     ge_run_cycle(&g);
     ge_fill_console_data(&g, &c);
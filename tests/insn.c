@@ -0,0 +1,86 @@
+#include <string.h>
+
+#include "utest.h"
+#include "lockstep.h"
+#include "../ge.h"
+#include "../insn.h"
+
+static void start(struct ge *g)
+{
+    test_program_start(g);
+
+    /* display and initialitiation */
+    ge_run_cycle(g);
+    ge_run_cycle(g);
+}
+
+UTEST(insn, same_as_cycles)
+{
+    struct ge g1, g2;
+    unsigned cycles;
+    int i = 0;
+
+    start(&g1);
+    start(&g2);
+
+    while (!g1.ALTO) {
+        cycles = ge_insn_run(&g2);
+        if (cycles == 0) {
+            ASSERT_EQ(ge_run_cycle(&g2), 0);
+            cycles = 1;
+        } else {
+            i++;
+        }
+
+        while (cycles--)
+            ASSERT_EQ(ge_run_cycle(&g1), 0);
+
+        ASSERT_EQ(g1.rSO, g2.rSO);
+        ASSERT_EQ(g1.rSA, g2.rSA);
+        ASSERT_EQ(g1.rPO, g2.rPO);
+        ASSERT_EQ(g1.rRO, g2.rRO);
+        ASSERT_EQ(g1.rBO, g2.rBO);
+        ASSERT_EQ(g1.rVO, g2.rVO);
+        ASSERT_EQ(g1.rFO, g2.rFO);
+        ASSERT_EQ(g1.rV1, g2.rV1);
+        ASSERT_EQ(g1.rV2, g2.rV2);
+        ASSERT_EQ(g1.rL1, g2.rL1);
+        ASSERT_EQ(g1.rL2, g2.rL2);
+        ASSERT_EQ(g1.ffFA, g2.ffFA);
+        ASSERT_EQ(g1.ffFI, g2.ffFI);
+        ASSERT_EQ(g1.ALAM, g2.ALAM);
+        ASSERT_EQ(g1.ADIR, g2.ADIR);
+        ASSERT_EQ(g1.ALTO, g2.ALTO);
+    }
+
+    /* everything but HLT */
+    ASSERT_EQ(i, 10);
+    ASSERT_TRUE(g2.ALTO);
+}
+
+UTEST(insn, fallback)
+{
+    struct ge g;
+    struct ge_console_switches s = { 0 };
+
+    start(&g);
+
+    /* not at the beginning of an instruction */
+    ge_run_pulse(&g);
+    ASSERT_EQ(ge_insn_run(&g), 0);
+    ge_run_cycle(&g);
+    ASSERT_EQ(ge_insn_run(&g), 0);
+    ge_run_cycle(&g);
+    ge_run_cycle(&g);
+    ASSERT_EQ(g.rPO, 2);
+
+    /* the switches need the single cycles */
+    s.PAPA = 1;
+    ge_set_console_switches(&g, &s);
+    ASSERT_EQ(ge_insn_run(&g), 0);
+
+    s.PAPA = 0;
+    ge_set_console_switches(&g, &s);
+    ASSERT_EQ(ge_insn_run(&g), 3);
+    ASSERT_EQ(g.rPO, 4);
+}
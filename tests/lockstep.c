@@ -0,0 +1,72 @@
+#include <string.h>
+
+#include "utest.h"
+#include "lockstep.h"
+#include "../ge.h"
+#include "../insn.h"
+#include "../signals.h"
+
+/* a broken engine, forgetting to count the instructions */
+static int broken_step(struct ge *ge, uint64_t *cycles)
+{
+    uint16_t po = ge->rPO;
+    unsigned n = ge_insn_run(ge);
+
+    if (n == 0)
+        return ge_lockstep_cycle(ge, cycles);
+
+    if (po > 4) {
+        ge->rPO = po;
+        knots_changed(ge);
+    }
+
+    *cycles += n;
+    return 0;
+}
+
+UTEST(lockstep, insn_engine)
+{
+    struct ge ref, cand;
+
+    test_program_start(&ref);
+    test_program_start(&cand);
+
+    ASSERT_LOCKSTEP(&ref, &cand, ge_run_step, 200);
+}
+
+UTEST(lockstep, interpreted_charts)
+{
+    struct ge ref, cand;
+
+    test_program_start(&ref);
+    test_program_start(&cand);
+    ref.msl_interpreted = 1;
+
+    ASSERT_LOCKSTEP(&ref, &cand, ge_lockstep_cycle, 200);
+}
+
+UTEST(lockstep, divergence)
+{
+    struct ge ref, cand;
+    struct ge_lockstep_report report;
+
+    test_program_start(&ref);
+    test_program_start(&cand);
+
+    ASSERT_EQ(ge_lockstep_run(&ref, &cand, broken_step, 200, &report), -1);
+    ASSERT_STREQ(report.field, "rPO");
+    ASSERT_EQ(report.reference, 10);
+    ASSERT_EQ(report.candidate, 6);
+    ASSERT_EQ(report.rSO, 0xe2);
+    ASSERT_EQ(report.clock, TO00);
+
+    /* memory */
+    test_program_start(&ref);
+    test_program_start(&cand);
+    cand.mem[0x1234] = 0x42;
+
+    ASSERT_EQ(ge_lockstep_compare(&ref, &cand, &report), -1);
+    ASSERT_STREQ(report.field, "mem");
+    ASSERT_EQ(report.addr, 0x1234);
+    ASSERT_EQ(report.candidate, 0x42);
+}
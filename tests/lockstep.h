@@ -0,0 +1,49 @@
+#ifndef TESTS_LOCKSTEP_H
+#define TESTS_LOCKSTEP_H
+
+#include "utest.h"
+#include "../ge.h"
+#include "../lockstep.h"
+
+/**
+ * Start `g` on the test program of the execution engines
+ *
+ * NOP2, LON, INS, JC, JS1, JIE, ENS, LOFF, JS2, NOP2 and HLT, none of the
+ * jumps taken. The machine is cleared and started, before the display
+ * and initialization cycles.
+ */
+static inline void test_program_start(struct ge *g)
+{
+    static uint8_t program[] = {
+        NOP2_OPCODE, 0x55,
+        LON_OPCODE,  LON_2NDCHAR,
+        INS_OPCODE,  INS_2NDCHAR,
+        JC_OPCODE,   0xf0, 0x01, 0x23,
+        JS1_OPCODE,  JS1_2NDCHAR, 0x00, 0x40,
+        JIE_OPCODE,  JIE_2NDCHAR, 0x0f, 0xff,
+        ENS_OPCODE,  ENS_2NDCHAR,
+        LOFF_OPCODE, LOFF_2NDCHAR,
+        JS2_OPCODE,  JS2_2NDCHAR, 0x02, 0x00,
+        NOP2_OPCODE, 0xaa,
+        HLT_OPCODE,  0x00,
+    };
+
+    ge_init(g);
+    ge_clear(g);
+    ge_load_program(g, program, sizeof(program));
+    ge_start(g);
+}
+
+/**
+ * Run two machines in lockstep for `cycles` cycles, failing the test
+ * with the divergence report if they do not match.
+ */
+#define ASSERT_LOCKSTEP(ref, cand, step, cycles)                        \
+    do {                                                                \
+        struct ge_lockstep_report report_;                              \
+        if (ge_lockstep_run((ref), (cand), (step), (cycles), &report_)) \
+            ge_lockstep_print(&report_, stderr);                        \
+        ASSERT_TRUE(report_.field == NULL);                             \
+    } while (0)
+
+#endif /* TESTS_LOCKSTEP_H */
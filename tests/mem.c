@@ -0,0 +1,108 @@
+#include <string.h>
+
+#include "utest.h"
+#include "../ge.h"
+#include "../mem.h"
+
+UTEST(mem, use_pages)
+{
+    uint8_t program[4] = {NOP2_OPCODE, 0xAA, NOP2_OPCODE, 0xBB};
+    struct ge g;
+
+    ge_init(&g);
+    ge_load_program(&g, program, sizeof(program));
+    g.mem[0x1234] = 0x55;
+
+    ASSERT_EQ(ge_mem_use_pages(&g), 0);
+    ASSERT_TRUE(g.pages->page[0x00] != NULL);
+    ASSERT_TRUE(g.pages->page[0x12] != NULL);
+    ASSERT_TRUE(g.pages->page[0x13] == NULL);
+
+    ASSERT_EQ(ge_mem_read(&g, 0x0001), 0xAA);
+    ASSERT_EQ(ge_mem_read(&g, 0x1234), 0x55);
+    ASSERT_EQ(ge_mem_read(&g, 0x1334), 0x00);
+
+    ge_deinit(&g);
+    ASSERT_TRUE(g.pages == NULL);
+}
+
+UTEST(mem, release)
+{
+    struct ge g;
+
+    ge_init(&g);
+    g.mem[0x1234] = 0x55;
+
+    ASSERT_EQ(ge_mem_use_pages(&g), 0);
+    ge_mem_write(&g, 0x1234, 0x66);
+    ge_mem_write(&g, 0x2000, 0x77);
+
+    /* back to the array, with what was written in the pages */
+    ge_mem_release(&g);
+    ASSERT_TRUE(g.pages == NULL);
+    ASSERT_EQ(g.mem[0x1234], 0x66);
+    ASSERT_EQ(g.mem[0x2000], 0x77);
+    ASSERT_EQ(g.mem[0x1334], 0x00);
+
+    ge_deinit(&g);
+}
+
+UTEST(mem, fork_copy_on_write)
+{
+    struct ge parent, child;
+
+    ge_init(&parent);
+    ASSERT_EQ(ge_mem_use_pages(&parent), 0);
+    ge_mem_write(&parent, 0x0100, 0x11);
+
+    ASSERT_EQ(ge_fork(&child, &parent), 0);
+    ASSERT_TRUE(child.pages->page[0x01] == parent.pages->page[0x01]);
+    ASSERT_EQ(ge_mem_read(&child, 0x0100), 0x11);
+
+    /* the page is unshared by the first write */
+    ge_mem_write(&child, 0x0101, 0x22);
+    ASSERT_TRUE(child.pages->page[0x01] != parent.pages->page[0x01]);
+    ASSERT_EQ(ge_mem_read(&child, 0x0100), 0x11);
+    ASSERT_EQ(ge_mem_read(&child, 0x0101), 0x22);
+    ASSERT_EQ(ge_mem_read(&parent, 0x0101), 0x00);
+
+    ge_mem_write(&parent, 0x0100, 0x33);
+    ASSERT_EQ(ge_mem_read(&child, 0x0100), 0x11);
+
+    ge_deinit(&child);
+    ge_deinit(&parent);
+}
+
+UTEST(mem, fork_and_run)
+{
+    uint8_t program[4] = {NOP2_OPCODE, 0xAA, NOP2_OPCODE, 0xBB};
+    struct ge g1, g2;
+    int i, p;
+
+    ge_init(&g1);
+    ASSERT_EQ(ge_mem_use_pages(&g1), 0);
+    ge_clear(&g1);
+    ge_load_program(&g1, program, sizeof(program));
+    ge_start(&g1);
+
+    ge_run_cycle(&g1);
+    ge_run_cycle(&g1);
+
+    ASSERT_EQ(ge_fork(&g2, &g1), 0);
+
+    for (i = 0; i < 10; i++) {
+        ge_run_cycle(&g1);
+        ge_run_cycle(&g2);
+
+        ASSERT_EQ(g2.rSO, g1.rSO);
+        ASSERT_EQ(g2.rPO, g1.rPO);
+        ASSERT_EQ(g2.rRO, g1.rRO);
+        ASSERT_EQ(g2.ffFA, g1.ffFA);
+    }
+
+    for (p = 0; p < MEM_PAGES; p++)
+        ASSERT_EQ(memcmp(ge_mem_page_data(&g1, p), ge_mem_page_data(&g2, p), MEM_PAGE_SIZE), 0);
+
+    ge_deinit(&g2);
+    ge_deinit(&g1);
+}
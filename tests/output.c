@@ -0,0 +1,192 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "utest.h"
+#include "../ge.h"
+#include "../deck.h"
+#include "../output.h"
+#include "../reader.h"
+#include "../writer.h"
+
+/* PER to `name`, output transfer of 5 characters from 0x40 */
+static void per_output(struct ge *g, uint8_t name, uint8_t z, uint8_t command)
+{
+    int i;
+
+    g->mem[0x00] = PER_OPCODE;
+    g->mem[0x01] = name;
+    g->mem[0x02] = 0x00;
+    g->mem[0x03] = 0x10;
+
+    g->mem[0x10] = z;
+    g->mem[0x11] = command;
+    g->mem[0x12] = 0x00;
+    g->mem[0x13] = 0x04;
+    g->mem[0x14] = 0x00;
+    g->mem[0x15] = 0x40;
+
+    for (i = 0; i < 8; i++)
+        g->mem[0x40 + i] = 0x41 + i;
+
+    ge_clear(g);
+    ge_start(g);
+
+    for (i = 0; i < 40; i++)
+        ge_run_cycle(g);
+}
+
+static size_t read_back(const char *path, uint8_t *buf, size_t size)
+{
+    FILE *f = fopen(path, "rb");
+    size_t n;
+
+    if (f == NULL)
+        return 0;
+
+    n = fread(buf, 1, size, f);
+    fclose(f);
+    return n;
+}
+
+UTEST(output, writer)
+{
+    struct ge_writer writer;
+    uint8_t buf[1000], out[1000];
+    FILE *f = tmpfile();
+    size_t i;
+
+    ASSERT_TRUE(f != NULL);
+
+    for (i = 0; i < sizeof(buf); i++)
+        buf[i] = i * 7;
+
+    /* much smaller than the data, the producer waits for room */
+    ASSERT_EQ(ge_writer_init(&writer, f, 16), 0);
+    for (i = 0; i < sizeof(buf); i += 10)
+        ASSERT_EQ(ge_writer_put(&writer, buf + i, 10), 0);
+    ASSERT_EQ(ge_writer_deinit(&writer), 0);
+
+    rewind(f);
+    ASSERT_EQ(fread(out, 1, sizeof(out), f), sizeof(buf));
+    ASSERT_EQ(memcmp(buf, out, sizeof(buf)), 0);
+    fclose(f);
+}
+
+UTEST(output, printer)
+{
+    char path[] = "/tmp/ge-output-XXXXXX";
+    struct ge_output out;
+    struct ge g;
+    uint8_t buf[0x100];
+    int fd = mkstemp(path);
+
+    ASSERT_TRUE(fd >= 0);
+    close(fd);
+
+    ge_init(&g);
+    ASSERT_EQ(ge_output_open(&out, GE_OUTPUT_PRINTER, path), 0);
+    ASSERT_EQ(ge_output_register(&g, &out, &g.ST3), 0);
+
+    /* ST3 is unit 00, without packing */
+    per_output(&g, 0x00, 0x50, READER_put_normal_1);
+    ASSERT_EQ(out.records, 1);
+
+    ge_deinit(&g);
+    ASSERT_EQ(ge_output_close(&out), 0);
+
+    ASSERT_EQ(read_back(path, buf, sizeof(buf)), 6);
+    ASSERT_EQ(memcmp(buf, "ABCDE\n", 6), 0);
+    unlink(path);
+}
+
+UTEST(output, punch)
+{
+    char path[] = "/tmp/ge-output-XXXXXX";
+    const uint8_t card[] = { 0x04, 0x01, 0x04, 0x02, 0x04, 0x00 };
+    struct ge_output out, other;
+    struct ge g;
+    uint8_t buf[0x100];
+    int fd = mkstemp(path);
+
+    ASSERT_TRUE(fd >= 0);
+    close(fd);
+
+    ge_init(&g);
+    ASSERT_EQ(ge_output_open(&out, GE_OUTPUT_PUNCH, path), 0);
+    ASSERT_EQ(ge_output_register(&g, &out, &g.ST4), 0);
+    ASSERT_EQ(ge_output_open(&other, GE_OUTPUT_PRINTER, "/dev/null"), 0);
+    ASSERT_EQ(ge_output_register(&g, &other, &g.ST3), 0);
+
+    /* ST4 is unit 40, with packing, a card of the deck format */
+    per_output(&g, 0x40, 0x40, READER_put_normal_1);
+    ASSERT_EQ(out.records, 1);
+    ASSERT_EQ(other.records, 0);
+
+    ge_deinit(&g);
+    ASSERT_EQ(ge_output_close(&out), 0);
+    ASSERT_EQ(ge_output_close(&other), 0);
+
+    ASSERT_EQ(read_back(path, buf, sizeof(buf)), GE_DECK_COLUMNS);
+    ASSERT_EQ(memcmp(buf, card, sizeof(card)), 0);
+    ASSERT_EQ(buf[GE_DECK_COLUMNS - 1], 0);
+    unlink(path);
+}
+
+UTEST(output, consecutive)
+{
+    char path[] = "/tmp/ge-output-XXXXXX";
+    struct ge_output out;
+    struct ge g;
+    uint8_t buf[0x100];
+    int fd = mkstemp(path);
+    int i;
+
+    ASSERT_TRUE(fd >= 0);
+    close(fd);
+
+    ge_init(&g);
+    ASSERT_EQ(ge_output_open(&out, GE_OUTPUT_PRINTER, path), 0);
+    ASSERT_EQ(ge_output_register(&g, &out, &g.ST3), 0);
+
+    /* the first PER has to complete for the second to run, and then the
+     * HLT */
+    g.mem[0x04] = PER_OPCODE;
+    g.mem[0x05] = 0x00;
+    g.mem[0x06] = 0x00;
+    g.mem[0x07] = 0x10;
+    g.mem[0x08] = HLT_OPCODE;
+    g.mem[0x09] = 0x00;
+    per_output(&g, 0x00, 0x50, READER_put_normal_1);
+
+    for (i = 0; i < 100 && !g.ALTO; i++)
+        ge_run_cycle(&g);
+
+    ASSERT_TRUE(g.ALTO);
+    ASSERT_EQ(out.records, 2);
+
+    ge_deinit(&g);
+    ASSERT_EQ(ge_output_close(&out), 0);
+
+    ASSERT_EQ(read_back(path, buf, sizeof(buf)), 12);
+    ASSERT_EQ(memcmp(buf, "ABCDE\nABCDE\n", 12), 0);
+    unlink(path);
+}
+
+UTEST(output, parse)
+{
+    enum ge_output_kind kind;
+    const char *path;
+
+    ASSERT_EQ(ge_output_parse("printer:out.txt", &kind, &path), 0);
+    ASSERT_EQ(kind, GE_OUTPUT_PRINTER);
+    ASSERT_STREQ(path, "out.txt");
+
+    ASSERT_EQ(ge_output_parse("punch:a:b", &kind, &path), 0);
+    ASSERT_EQ(kind, GE_OUTPUT_PUNCH);
+    ASSERT_STREQ(path, "a:b");
+
+    ASSERT_EQ(ge_output_parse("print:out.txt", &kind, &path), -1);
+    ASSERT_EQ(ge_output_parse("printer", &kind, &path), -1);
+}
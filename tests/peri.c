@@ -1,3 +1,5 @@
+#include <unistd.h>
+
 #include "utest.h"
 
 #include "../ge.h"
@@ -95,3 +97,81 @@ UTEST(peripheral, peri_null)
     r = ge_deinit(&g);
     ASSERT_EQ(r, 0);
 }
+
+UTEST(peripheral, wake_on_clocks)
+{
+    struct peri_ctx ctx = { 0 };
+    struct ge_peri p = { 0 };
+    struct ge g;
+
+    p.on_pulse = &peri_test_on_pulse;
+    p.ctx = &ctx;
+
+    ge_init(&g);
+    ASSERT_EQ(ge_register_peri(&g, &p), 0);
+    ge_peri_wake_on_clocks(&p, GE_CLOCK_BIT(TO10) | GE_CLOCK_BIT(TO80));
+
+    ge_start(&g);
+    ge_run_cycle(&g);
+    ge_run_cycle(&g);
+    ASSERT_EQ(ctx.test_pulses, 4);
+}
+
+UTEST(peripheral, wake_every)
+{
+    struct peri_ctx ctx = { 0 };
+    struct ge_peri p = { 0 };
+    struct ge g;
+    int i;
+
+    p.on_pulse = &peri_test_on_pulse;
+    p.on_clock = &peri_test_on_clock;
+    p.ctx = &ctx;
+
+    ge_init(&g);
+    ASSERT_EQ(ge_register_peri(&g, &p), 0);
+    ge_peri_wake_on_clocks(&p, GE_CLOCK_BIT(TO00));
+    ge_peri_wake_every(&p, 3);
+
+    ge_start(&g);
+    for (i = 0; i < 7; i++)
+        ge_run_cycle(&g);
+
+    /* on_clock is not scheduled */
+    ASSERT_EQ(ctx.test_clocks, 7);
+    ASSERT_EQ(ctx.test_pulses, 3);
+}
+
+UTEST(peripheral, wake_on_fd)
+{
+    struct peri_ctx ctx = { 0 };
+    struct ge_peri p = { 0 };
+    struct ge g;
+    int fds[2];
+    char c = 0;
+
+    ASSERT_EQ(pipe(fds), 0);
+
+    p.on_pulse = &peri_test_on_pulse;
+    p.ctx = &ctx;
+
+    ge_init(&g);
+    ASSERT_EQ(ge_register_peri(&g, &p), 0);
+    ge_peri_wake_on_clocks(&p, GE_CLOCK_BIT(TO00));
+    ge_peri_wake_on_fd(&p, fds[0]);
+
+    ge_start(&g);
+    ge_run_cycle(&g);
+    ASSERT_EQ(ctx.test_pulses, 0);
+
+    ASSERT_EQ(write(fds[1], &c, 1), 1);
+    ge_run_cycle(&g);
+    ASSERT_EQ(ctx.test_pulses, 1);
+
+    ASSERT_EQ(read(fds[0], &c, 1), 1);
+    ge_run_cycle(&g);
+    ASSERT_EQ(ctx.test_pulses, 1);
+
+    close(fds[0]);
+    close(fds[1]);
+}
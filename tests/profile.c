@@ -0,0 +1,203 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "utest.h"
+#include "lockstep.h"
+#include "../ge.h"
+#include "../insn.h"
+#include "../mem.h"
+#include "../msl-timings.h"
+#include "../profile.h"
+
+static struct ge_profile profile1, profile2;
+static struct ge_guest_profile guest1, guest2;
+
+static void run(struct ge *g, struct ge_profile *profile, uint8_t interpreted)
+{
+    test_program_start(g);
+    ge_profile_init(profile);
+    ge_set_profile(g, profile);
+    g->msl_interpreted = interpreted;
+
+    while (!g->ALTO)
+        ge_run_cycle(g);
+}
+
+UTEST(profile, states)
+{
+    struct ge g;
+    uint64_t cycles;
+
+    run(&g, &profile1, 0);
+
+    /* display, initialitiation, then every instruction starts in E2 */
+    ASSERT_EQ(profile1.states[0x00].cycles, 1);
+    ASSERT_EQ(profile1.states[0x80].cycles, 1);
+    ASSERT_EQ(profile1.states[0xe2].cycles, 11);
+    ASSERT_EQ(profile1.states[0x64].cycles, 6);
+    ASSERT_EQ(profile1.states[0x65].cycles, 4);
+    ASSERT_EQ(profile1.states[0xe4].cycles, 4);
+    ASSERT_EQ(profile1.states[0xe6].cycles, 4);
+
+    cycles = profile1.states[0xe2].cycles;
+    ASSERT_TRUE(profile1.states[0xe2].pulses >= cycles);
+    ASSERT_TRUE(profile1.states[0xe2].ticks > 0);
+
+    /* the profile needs every pulse */
+    ASSERT_EQ(ge_insn_run(&g), 0);
+
+    ge_deinit(&g);
+}
+
+UTEST(profile, fork)
+{
+    struct ge g, fork;
+    struct ge_profile_state before;
+    uint32_t current;
+    int i;
+
+    run(&g, &profile1, 0);
+    before = profile1.states[0xe2];
+
+    ge_guest_profile_init(&guest1);
+    ge_set_guest_profile(&g, &guest1);
+    current = guest1.current;
+
+    /* the fork does not count in the profiles of its parent */
+    ASSERT_EQ(ge_fork(&fork, &g), 0);
+    ASSERT_TRUE(fork.profile == NULL);
+    ASSERT_TRUE(fork.profile_rows == NULL);
+    ASSERT_TRUE(fork.guest_profile == NULL);
+
+    ge_start(&fork);
+    for (i = 0; i < 20; i++)
+        ge_run_cycle(&fork);
+
+    ASSERT_EQ(memcmp(&profile1.states[0xe2], &before, sizeof(before)), 0);
+    ASSERT_EQ(guest1.current, current);
+    for (i = 0; i < MEM_SIZE; i++)
+        ASSERT_EQ(guest1.fetches[i], 0);
+
+    ge_deinit(&fork);
+    ge_deinit(&g);
+}
+
+UTEST(profile, compiled_same_as_interpreted)
+{
+    struct ge g1, g2;
+    uint64_t fired = 0;
+    int i;
+
+    run(&g1, &profile1, 0);
+    run(&g2, &profile2, 1);
+
+    for (i = 0; i < 0x100; i++) {
+        ASSERT_EQ(profile1.states[i].cycles, profile2.states[i].cycles);
+        ASSERT_EQ(profile1.states[i].pulses, profile2.states[i].pulses);
+    }
+
+    for (i = 0; i < MSL_MAX_ROWS; i++) {
+        ASSERT_EQ(profile1.rows[i].runs, profile2.rows[i].runs);
+        ASSERT_EQ(profile1.rows[i].fired, profile2.rows[i].fired);
+        ASSERT_EQ(profile1.rows[i].additional_false, profile2.rows[i].additional_false);
+        ASSERT_EQ(profile1.rows[i].condition_false, profile2.rows[i].condition_false);
+        ASSERT_EQ(profile1.rows[i].runs,
+                  profile1.rows[i].fired +
+                  profile1.rows[i].additional_false +
+                  profile1.rows[i].condition_false);
+        fired += profile1.rows[i].fired;
+    }
+
+    ASSERT_TRUE(fired > 0);
+
+    ge_deinit(&g1);
+    ge_deinit(&g2);
+}
+
+UTEST(profile, report)
+{
+    struct ge g;
+    char buf[0x10000];
+    FILE *f = tmpfile();
+    size_t n;
+
+    ASSERT_TRUE(f != NULL);
+
+    run(&g, &profile1, 0);
+
+    ge_profile_init(&profile2);
+    ge_profile_merge(&profile2, &profile1);
+    ge_profile_merge(&profile2, &profile1);
+    ASSERT_EQ(profile2.states[0xe2].cycles, 22);
+
+    ASSERT_EQ(ge_profile_write_json(&profile1, f), 0);
+    rewind(f);
+    n = fread(buf, 1, sizeof(buf) - 1, f);
+    buf[n] = 0;
+    fclose(f);
+
+    ASSERT_EQ(buf[0], '{');
+    ASSERT_TRUE(strstr(buf, "\"states\": [") != NULL);
+    ASSERT_TRUE(strstr(buf, "{\"state\": \"e2\", \"cycles\": 11,") != NULL);
+    ASSERT_TRUE(strstr(buf, "{\"command\": \"CI39\", ") != NULL);
+    ASSERT_TRUE(strstr(buf, "\"rows\": [") != NULL);
+    ASSERT_TRUE(strstr(buf, "\n  ]\n}\n") != NULL);
+
+    ge_deinit(&g);
+}
+
+UTEST(profile, guest)
+{
+    struct ge g1, g2;
+    uint64_t cycles = 0;
+    char buf[0x1000];
+    FILE *f = tmpfile();
+    size_t n;
+    int i;
+
+    ASSERT_TRUE(f != NULL);
+
+    /* cycle by cycle */
+    test_program_start(&g1);
+    ge_guest_profile_init(&guest1);
+    ge_set_guest_profile(&g1, &guest1);
+
+    while (!g1.ALTO)
+        ge_run_cycle(&g1);
+
+    ASSERT_EQ(guest1.fetches[0], 1);
+    ASSERT_EQ(guest1.cycles[0], 3);
+    ASSERT_EQ(guest1.fetches[2], 1);
+    ASSERT_EQ(guest1.cycles[2], 3);
+    ASSERT_EQ(guest1.fetches[6], 1);
+    ASSERT_EQ(guest1.cycles[6], 5);
+    ASSERT_EQ(guest1.fetches[26], 1);
+    ASSERT_EQ(guest1.fetches[28], 1);
+    ASSERT_EQ(guest1.fetches[8], 0);
+
+    /* whole instructions */
+    test_program_start(&g2);
+    ge_guest_profile_init(&guest2);
+    ge_set_guest_profile(&g2, &guest2);
+
+    while (!g2.ALTO)
+        ge_run_step(&g2, &cycles);
+
+    for (i = 0; i < MEM_SIZE; i++) {
+        ASSERT_EQ(guest1.fetches[i], guest2.fetches[i]);
+        ASSERT_EQ(guest1.cycles[i], guest2.cycles[i]);
+    }
+
+    ge_guest_profile_print(&guest1, &g1, f);
+    rewind(f);
+    n = fread(buf, 1, sizeof(buf) - 1, f);
+    buf[n] = 0;
+    fclose(f);
+
+    ASSERT_TRUE(strstr(buf, "\n0000 NOP2 07 55  ") != NULL);
+    ASSERT_TRUE(strstr(buf, "\n0006 JC   43 F0 0123  ") != NULL);
+    ASSERT_TRUE(strstr(buf, "\n001C HLT  0A 00  ") != NULL);
+
+    ge_deinit(&g1);
+    ge_deinit(&g2);
+}
@@ -27,3 +27,36 @@ UTEST(signals, channel_selection)
     g.rL2 = channel_3;
     ASSERT_TRUE(PC031(&g));
 }
+
+UTEST(signals, knots_cache)
+{
+    struct ge g;
+
+    ge_init(&g);
+
+    g.rBO = 0x1233;
+    g.rRO = 0xab;
+    g.counting_network.cmds.from_zero = 1;
+    g.kNI.ni1 = NS_CN1;
+    g.kNI.ni2 = NS_CN2;
+    g.kNI.ni3 = NS_RO1;
+    g.kNI.ni4 = NS_RO2;
+    knots_changed(&g);
+    ASSERT_EQ(NI_knot(&g), 0xab34);
+
+    /* cached until invalidated */
+    g.rRO = 0xcd;
+    ASSERT_EQ(NI_knot(&g), 0xab34);
+    NI_changed(&g);
+    ASSERT_EQ(NI_knot(&g), 0xcd34);
+
+    g.rV1 = 0x1010;
+    g.kNO.cmd = KNOT_V1_IN_NO;
+    NO_changed(&g);
+    ASSERT_EQ(NO_knot(&g), 0x1010);
+
+    g.kNO.forcings = 0x42;
+    g.kNO.force_mode = KNOT_FORCING_NO_43;
+    NO_changed(&g);
+    ASSERT_EQ(NO_knot(&g), 0x5200);
+}
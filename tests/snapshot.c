@@ -0,0 +1,124 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "utest.h"
+#include "../ge.h"
+#include "../snapshot.h"
+
+struct counter {
+    uint16_t value;
+};
+
+static int counter_save(struct ge *ge, void *ctx, struct ge_snapshot_buf *buf)
+{
+    struct counter *c = (struct counter *)ctx;
+
+    return ge_snapshot_put(buf, &c->value, sizeof(c->value));
+}
+
+static int counter_load(struct ge *ge, void *ctx, const uint8_t *data, size_t size)
+{
+    struct counter *c = (struct counter *)ctx;
+
+    if (size != sizeof(c->value))
+        return -1;
+
+    memcpy(&c->value, data, size);
+    return 0;
+}
+
+UTEST(snapshot, resume)
+{
+    uint8_t mem[4] = {NOP2_OPCODE, 0xAA, NOP2_OPCODE, 0xBB};
+    struct ge g1, g2;
+    FILE *f = tmpfile();
+    int i;
+
+    ASSERT_TRUE(f != NULL);
+
+    ge_init(&g1);
+    ge_clear(&g1);
+    ge_load_program(&g1, mem, sizeof(mem));
+    g1.mem[0x1234] = 0x55;
+    ge_start(&g1);
+
+    /* display, initialitiation and part of the first instruction */
+    ge_run_cycle(&g1);
+    ge_run_cycle(&g1);
+    ge_run_cycle(&g1);
+    ge_run_pulse(&g1);
+    ge_run_pulse(&g1);
+
+    ASSERT_EQ(ge_snapshot_save(&g1, f), 0);
+    rewind(f);
+
+    ge_init(&g2);
+    ASSERT_EQ(ge_snapshot_load(&g2, f), 0);
+    fclose(f);
+
+    ASSERT_EQ(g2.current_clock, g1.current_clock);
+    ASSERT_EQ(g2.mem[0x1234], 0x55);
+
+    for (i = 0; i < 10; i++) {
+        ge_run_cycle(&g1);
+        ge_run_cycle(&g2);
+
+        ASSERT_EQ(g2.rSO, g1.rSO);
+        ASSERT_EQ(g2.rPO, g1.rPO);
+        ASSERT_EQ(g2.rRO, g1.rRO);
+        ASSERT_EQ(g2.rBO, g1.rBO);
+        ASSERT_EQ(g2.rFO, g1.rFO);
+        ASSERT_EQ(g2.rV1, g1.rV1);
+        ASSERT_EQ(g2.rL1, g1.rL1);
+        ASSERT_EQ(g2.ffFA, g1.ffFA);
+        ASSERT_EQ(g2.ffFI, g1.ffFI);
+    }
+
+    ASSERT_EQ(memcmp(g1.mem, g2.mem, MEM_SIZE), 0);
+}
+
+UTEST(snapshot, peripheral_section)
+{
+    struct counter c1 = { 0x1234 };
+    struct counter c2 = { 0 };
+    struct ge_snapshot_section s1 = { .name = "counter", .save = counter_save, .ctx = &c1 };
+    struct ge_snapshot_section s2 = { .name = "counter", .load = counter_load, .ctx = &c2 };
+    struct ge_snapshot_section dup = { .name = "counter" };
+    struct ge g1, g2;
+    FILE *f = tmpfile();
+
+    ASSERT_TRUE(f != NULL);
+
+    ge_init(&g1);
+    ASSERT_EQ(ge_snapshot_register_section(&g1, &s1), 0);
+    ASSERT_EQ(ge_snapshot_register_section(&g1, &dup), -1);
+    ASSERT_EQ(ge_snapshot_save(&g1, f), 0);
+
+    /* not registered, skipped */
+    rewind(f);
+    ge_init(&g2);
+    ASSERT_EQ(ge_snapshot_load(&g2, f), 0);
+    ASSERT_EQ(c2.value, 0);
+
+    rewind(f);
+    ASSERT_EQ(ge_snapshot_register_section(&g2, &s2), 0);
+    ASSERT_EQ(ge_snapshot_load(&g2, f), 0);
+    ASSERT_EQ(c2.value, 0x1234);
+
+    fclose(f);
+}
+
+UTEST(snapshot, bad_magic)
+{
+    struct ge g;
+    FILE *f = tmpfile();
+
+    ASSERT_TRUE(f != NULL);
+    fputs("GETRACE not a snapshot", f);
+    rewind(f);
+
+    ge_init(&g);
+    ASSERT_EQ(ge_snapshot_load(&g, f), -1);
+
+    fclose(f);
+}
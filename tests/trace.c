@@ -0,0 +1,131 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+
+#include "utest.h"
+#include "../ge.h"
+#include "../trace.h"
+
+UTEST(trace, drop_when_full)
+{
+    struct ge_trace t;
+    struct ge_trace_record r = { 0 };
+    int i;
+
+    ASSERT_EQ(ge_trace_init(&t, 3, TRACE_FLUSH_SELF), 0);
+    ASSERT_EQ(t.size, 4);
+
+    for (i = 0; i < 6; i++)
+        ge_trace_append(&t, &r);
+
+    ASSERT_EQ(ge_trace_pending(&t), 4);
+    ASSERT_EQ(t.dropped, 2);
+
+    ge_trace_deinit(&t);
+}
+
+UTEST(trace, flush_to_file)
+{
+    uint8_t mem[2] = {NOP2_OPCODE, 0xAA};
+    struct ge_trace_record r;
+    struct ge_trace t;
+    struct ge g;
+    FILE *f = tmpfile();
+    int pulses = 0;
+    int cycles = 0;
+    char line[0x100];
+
+    ASSERT_TRUE(f != NULL);
+
+    /* smaller than a cycle, to flush while running */
+    ASSERT_EQ(ge_trace_init(&t, 8, TRACE_FLUSH_SELF), 0);
+    ASSERT_EQ(ge_trace_set_file(&t, f), 0);
+
+    ge_init(&g);
+    ge_set_trace(&g, &t);
+    ge_clear(&g);
+    ge_load_program(&g, mem, sizeof(mem));
+    ge_start(&g);
+
+    /* display, initialitiation */
+    ge_run_cycle(&g);
+    ge_run_cycle(&g);
+
+    ge_trace_deinit(&t);
+    ASSERT_EQ(t.dropped, 0);
+
+    rewind(f);
+    ASSERT_EQ(ge_trace_read_header(f), 0);
+
+    while (fread(&r, sizeof(r), 1, f) == 1) {
+        if (r.kind == TRACE_PULSE)
+            pulses++;
+
+        if (r.kind == TRACE_CYCLE) {
+            /* state 00 goes to 80, 80 goes to e2 or e3 */
+            ASSERT_EQ(r.rSO, cycles == 0 ? 0x80 : (g.rSO));
+            cycles++;
+        }
+    }
+
+    ASSERT_TRUE(pulses > 0);
+    ASSERT_EQ(cycles, 2);
+
+    ge_trace_format(&r, line, sizeof(line));
+    ASSERT_EQ(strncmp(line, "SO: ", 4), 0);
+
+    fclose(f);
+}
+
+static atomic_int consumer_stop;
+
+static void *consumer_run(void *arg)
+{
+    struct ge_trace *t = arg;
+
+    while (!atomic_load(&consumer_stop))
+        ge_trace_flush(t);
+
+    return NULL;
+}
+
+UTEST(trace, external_consumer)
+{
+    struct ge_trace_record r = { 0 };
+    struct ge_trace t;
+    pthread_t consumer;
+    FILE *f = tmpfile();
+    uint64_t written = 0;
+    int i;
+
+    ASSERT_TRUE(f != NULL);
+    ASSERT_EQ(ge_trace_init(&t, 4, TRACE_FLUSH_EXTERNAL), 0);
+    ASSERT_EQ(ge_trace_set_file(&t, f), 0);
+
+    /* full, with a file: dropped, the emulator does not flush */
+    for (i = 0; i < 6; i++)
+        ge_trace_append(&t, &r);
+    ASSERT_EQ(ge_trace_pending(&t), 4);
+    ASSERT_EQ(t.dropped, 2);
+
+    atomic_store(&consumer_stop, 0);
+    ASSERT_EQ(pthread_create(&consumer, NULL, consumer_run, &t), 0);
+
+    for (i = 0; i < 10000; i++) {
+        r.rPO = i;
+        ge_trace_append(&t, &r);
+    }
+
+    atomic_store(&consumer_stop, 1);
+    pthread_join(consumer, NULL);
+    ge_trace_deinit(&t);
+
+    /* every record is either in the file or dropped */
+    rewind(f);
+    ASSERT_EQ(ge_trace_read_header(f), 0);
+    while (fread(&r, sizeof(r), 1, f) == 1)
+        written++;
+    ASSERT_EQ(written + t.dropped, 10006);
+
+    fclose(f);
+}
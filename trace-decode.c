@@ -0,0 +1,68 @@
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "trace.h"
+#include "log.h"
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+            "usage: %s [-c | -a] trace-file\n"
+            "\n"
+            "Shows the registers dumped at every pulse, as with LOG_REGS_V.\n"
+            "\n"
+            "  -c  show the registers dumped at every cycle, as with LOG_REGS\n"
+            "  -a  show both\n",
+            name);
+}
+
+int main(int argc, char *argv[])
+{
+    struct ge_trace_record record;
+    uint8_t show_pulses = 1;
+    uint8_t show_cycles = 0;
+    char line[0x100];
+    FILE *file;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "cah")) != -1) {
+        switch (opt) {
+            case 'c': show_pulses = 0; show_cycles = 1; break;
+            case 'a': show_pulses = 1; show_cycles = 1; break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (optind != argc - 1) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    file = fopen(argv[optind], "rb");
+    if (file == NULL) {
+        perror(argv[optind]);
+        return 1;
+    }
+
+    if (ge_trace_read_header(file) != 0) {
+        fprintf(stderr, "%s: not a trace file\n", argv[optind]);
+        fclose(file);
+        return 1;
+    }
+
+    while (fread(&record, sizeof(record), 1, file) == 1) {
+        if (record.kind == TRACE_PULSE && !show_pulses)
+            continue;
+
+        if (record.kind == TRACE_CYCLE && !show_cycles)
+            continue;
+
+        ge_trace_format(&record, line, sizeof(line));
+        ge_log_message(record.kind == TRACE_PULSE ? LOG_REGS_V : LOG_REGS, "%s", line);
+    }
+
+    fclose(file);
+    return 0;
+}
@@ -0,0 +1,145 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "trace.h"
+#include "ge.h"
+
+int ge_trace_init(struct ge_trace *trace, uint32_t size, enum ge_trace_consumer consumer)
+{
+    uint32_t s = 1;
+
+    while (s < size)
+        s <<= 1;
+
+    memset(trace, 0, sizeof(*trace));
+
+    trace->records = calloc(s, sizeof(struct ge_trace_record));
+    if (trace->records == NULL)
+        return -1;
+
+    trace->size = s;
+    trace->consumer = consumer;
+    atomic_init(&trace->head, 0);
+    atomic_init(&trace->tail, 0);
+    atomic_init(&trace->dropped, 0);
+    return 0;
+}
+
+void ge_trace_deinit(struct ge_trace *trace)
+{
+    if (trace->file)
+        ge_trace_flush(trace);
+
+    free(trace->records);
+    trace->records = NULL;
+    trace->size = 0;
+}
+
+int ge_trace_set_file(struct ge_trace *trace, FILE *file)
+{
+    struct ge_trace_header header = { GE_TRACE_MAGIC };
+
+    header.version = GE_TRACE_VERSION;
+    header.record_size = sizeof(struct ge_trace_record);
+
+    if (fwrite(&header, sizeof(header), 1, file) != 1)
+        return -1;
+
+    trace->file = file;
+    return 0;
+}
+
+uint32_t ge_trace_pending(struct ge_trace *trace)
+{
+    uint64_t head = atomic_load_explicit(&trace->head, memory_order_acquire);
+    uint64_t tail = atomic_load_explicit(&trace->tail, memory_order_acquire);
+
+    return head - tail;
+}
+
+void ge_trace_append(struct ge_trace *trace, const struct ge_trace_record *record)
+{
+    uint64_t head = atomic_load_explicit(&trace->head, memory_order_relaxed);
+    uint64_t tail = atomic_load_explicit(&trace->tail, memory_order_acquire);
+
+    if (head - tail == trace->size) {
+        /* only the consumer may flush */
+        if (trace->consumer != TRACE_FLUSH_SELF || trace->file == NULL ||
+            ge_trace_flush(trace) != 0) {
+            atomic_fetch_add_explicit(&trace->dropped, 1, memory_order_relaxed);
+            return;
+        }
+    }
+
+    trace->records[head & (trace->size - 1)] = *record;
+    atomic_store_explicit(&trace->head, head + 1, memory_order_release);
+}
+
+int ge_trace_flush(struct ge_trace *trace)
+{
+    uint64_t head = atomic_load_explicit(&trace->head, memory_order_acquire);
+    uint64_t tail = atomic_load_explicit(&trace->tail, memory_order_relaxed);
+    uint32_t start, count;
+
+    if (trace->file == NULL)
+        return -1;
+
+    while (tail != head) {
+        /* write up to the end of the buffer, then wrap around */
+        start = tail & (trace->size - 1);
+        count = trace->size - start;
+        if (count > head - tail)
+            count = head - tail;
+
+        if (fwrite(&trace->records[start], sizeof(struct ge_trace_record),
+                   count, trace->file) != count)
+            return -1;
+
+        tail += count;
+        atomic_store_explicit(&trace->tail, tail, memory_order_release);
+    }
+
+    return fflush(trace->file) == 0 ? 0 : -1;
+}
+
+int ge_trace_read_header(FILE *file)
+{
+    struct ge_trace_header header;
+
+    if (fread(&header, sizeof(header), 1, file) != 1)
+        return -1;
+
+    if (memcmp(header.magic, GE_TRACE_MAGIC, sizeof(GE_TRACE_MAGIC)) != 0 ||
+        header.version != GE_TRACE_VERSION ||
+        header.record_size != sizeof(struct ge_trace_record))
+        return -1;
+
+    return 0;
+}
+
+int ge_trace_format(const struct ge_trace_record *r, char *buf, size_t size)
+{
+    if (r->kind == TRACE_CYCLE) {
+        return snprintf(buf, size,
+                        "SO: %02x SA: %02x PO: %04x RO: %04x BO: %04x FO: %04x -  "
+                        "V1: %04x  V2: %04x V3: %04x  V4: %04x - "
+                        "L1: %04x  L2: %04x L3 : %04x\n",
+                        r->rSO, r->rSA, r->rPO, r->rRO, r->rBO, r->rFO,
+                        r->rV1, r->rV2, r->rV3, r->rV4,
+                        r->rL1, r->rL2, r->rL3);
+    }
+
+    return snprintf(buf, size,
+                    "%s:  "
+                    "SO: %02x SA: %02x PO: %04x RO: %04x BO: %04x FO: %04x  -  "
+                    "NO: %02x NI: %02x  -  "
+                    "FA: %02x FI: %02x - "
+                    "V1: %04x  V2: %04x V3: %04x  V4: %04x - "
+                    "L1: %04x  L2: %04x L3 : %04x\n",
+                    ge_clock_name(r->clock),
+                    r->rSO, r->rSA, r->rPO, r->rRO, r->rBO, r->rFO,
+                    r->NO, r->NI,
+                    r->ffFA, r->ffFI,
+                    r->rV1, r->rV2, r->rV3, r->rV4,
+                    r->rL1, r->rL2, r->rL3);
+}
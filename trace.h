@@ -0,0 +1,160 @@
+/**
+ * @file  trace.h
+ * @brief Binary register trace
+ *
+ * A compact alternative to the LOG_REGS and LOG_REGS_V register dumps:
+ * instead of being formatted with printf, the registers are stored as
+ * fixed size records in an in-memory ring buffer, which can be flushed
+ * to a file and rendered later with the `ge-trace` tool.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define GE_TRACE_MAGIC   "GETRACE"
+#define GE_TRACE_VERSION 1
+
+enum ge_trace_kind {
+    TRACE_PULSE, ///< Registers dumped while running a timing chart row (LOG_REGS_V)
+    TRACE_CYCLE, ///< Registers dumped at the end of a cycle (LOG_REGS)
+};
+
+/// Who flushes the records of a trace
+enum ge_trace_consumer {
+    TRACE_FLUSH_SELF,     ///< The emulator, when the buffer is full or with ge_trace_flush()
+    TRACE_FLUSH_EXTERNAL, ///< One other thread, with ge_trace_flush()
+};
+
+/**
+ * Trace record
+ *
+ * A snapshot of the registers shown by the register dumps.
+ */
+struct ge_trace_record {
+    uint16_t rPO;
+    uint16_t rRO;
+    uint16_t rBO;
+    uint16_t NO;
+    uint16_t NI;
+    uint16_t rV1;
+    uint16_t rV2;
+    uint16_t rV3;
+    uint16_t rV4;
+    uint16_t rL1;
+    uint16_t rL3;
+
+    uint8_t kind;  ///< One of #ge_trace_kind
+    uint8_t clock; ///< The clock of the pulse, see #clock
+    uint8_t rSO;
+    uint8_t rSA;
+    uint8_t rFO;
+    uint8_t ffFA;
+    uint8_t ffFI;
+    uint8_t rL2;
+
+    uint16_t _pad0;
+};
+
+/**
+ * Trace file header
+ *
+ * Written at the start of a trace file, followed by the records.
+ */
+struct ge_trace_header {
+    char     magic[8];    ///< GE_TRACE_MAGIC
+    uint16_t version;     ///< GE_TRACE_VERSION
+    uint16_t record_size; ///< sizeof(struct ge_trace_record)
+    uint32_t _pad0;
+};
+
+/**
+ * Trace ring buffer
+ *
+ * Single producer, single consumer: the emulator appends records, and
+ * either the emulator itself or one other thread flushes them, as chosen
+ * with ge_trace_init(). Neither side takes locks.
+ *
+ * When the buffer is full, the emulator flushes it if it is the consumer
+ * and a file has been set. Otherwise new records are dropped and counted
+ * in `dropped`.
+ */
+struct ge_trace {
+    struct ge_trace_record *records;
+    uint32_t size; ///< Number of records, a power of two
+    enum ge_trace_consumer consumer;
+
+    _Atomic uint64_t head; ///< Next record to write, owned by the producer
+    _Atomic uint64_t tail; ///< Next record to flush, owned by the consumer
+
+    FILE *file;              ///< Owned by the consumer once set
+    _Atomic uint64_t dropped;
+};
+
+/**
+ * Initialize a trace
+ *
+ * @param trace the trace to initialize
+ * @param size     the number of records of the ring buffer, rounded up
+ *                 to a power of two
+ * @param consumer who flushes the records: with TRACE_FLUSH_EXTERNAL the
+ *                 emulator never does, only the other thread may call
+ *                 ge_trace_flush()
+ * @return 0 on success, -1 if the buffer could not be allocated
+ */
+int ge_trace_init(struct ge_trace *trace, uint32_t size, enum ge_trace_consumer consumer);
+
+/**
+ * Deinitialize a trace
+ *
+ * Flushes the pending records, if a file has been set, and frees the
+ * ring buffer. The file is not closed. With TRACE_FLUSH_EXTERNAL, the
+ * other thread must have stopped flushing.
+ */
+void ge_trace_deinit(struct ge_trace *trace);
+
+/**
+ * Set the file to flush records to
+ *
+ * Writes the trace file header.
+ *
+ * @return 0 on success, -1 on write errors
+ */
+int ge_trace_set_file(struct ge_trace *trace, FILE *file);
+
+/// Append a record, flushing the buffer if it is full and the emulator is the consumer
+void ge_trace_append(struct ge_trace *trace, const struct ge_trace_record *record);
+
+/**
+ * Flush the pending records to the file
+ *
+ * @return 0 on success, -1 on write errors or if no file has been set
+ */
+int ge_trace_flush(struct ge_trace *trace);
+
+/// Number of records waiting to be flushed
+uint32_t ge_trace_pending(struct ge_trace *trace);
+
+/**
+ * Read a trace file header
+ *
+ * @return 0 if the header is valid, -1 otherwise
+ */
+int ge_trace_read_header(FILE *file);
+
+/**
+ * Format a record
+ *
+ * Renders the record with the same text as the register dump logs,
+ * without the log prefix.
+ *
+ * @return the number of characters that would have been written, as
+ *         snprintf
+ */
+int ge_trace_format(const struct ge_trace_record *record, char *buf, size_t size);
+
+#endif /* TRACE_H */
@@ -0,0 +1,160 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "writer.h"
+
+static void *writer_thread(void *arg)
+{
+    struct ge_writer *writer = arg;
+    uint64_t head, tail;
+    uint32_t start, count;
+    uint8_t stop;
+    int error = 0;
+
+    for (;;) {
+        pthread_mutex_lock(&writer->lock);
+        for (;;) {
+            head = atomic_load_explicit(&writer->head, memory_order_acquire);
+            tail = atomic_load_explicit(&writer->tail, memory_order_relaxed);
+            stop = writer->stop;
+
+            if (head != tail || stop)
+                break;
+
+            pthread_cond_wait(&writer->wake, &writer->lock);
+        }
+        pthread_mutex_unlock(&writer->lock);
+
+        /* write up to the end of the buffer, then wrap around */
+        while (tail != head) {
+            start = tail & (writer->size - 1);
+            count = writer->size - start;
+            if (count > head - tail)
+                count = head - tail;
+
+            if (!error && fwrite(writer->buf + start, 1, count, writer->file) != count)
+                error = -1;
+
+            tail += count;
+            atomic_store_explicit(&writer->tail, tail, memory_order_release);
+        }
+
+        if (!error && fflush(writer->file) != 0)
+            error = -1;
+
+        pthread_mutex_lock(&writer->lock);
+        writer->error = error;
+        pthread_cond_signal(&writer->room);
+        pthread_mutex_unlock(&writer->lock);
+
+        /* the producer has stopped, all its data has been seen */
+        if (stop)
+            return NULL;
+    }
+}
+
+int ge_writer_init(struct ge_writer *writer, FILE *file, uint32_t size)
+{
+    uint32_t s = 1;
+
+    while (s < size)
+        s <<= 1;
+
+    memset(writer, 0, sizeof(*writer));
+
+    writer->buf = malloc(s);
+    if (writer->buf == NULL)
+        return -1;
+
+    writer->size = s;
+    writer->file = file;
+    atomic_init(&writer->head, 0);
+    atomic_init(&writer->tail, 0);
+
+    pthread_mutex_init(&writer->lock, NULL);
+    pthread_cond_init(&writer->wake, NULL);
+    pthread_cond_init(&writer->room, NULL);
+
+    if (pthread_create(&writer->thread, NULL, writer_thread, writer) != 0) {
+        pthread_cond_destroy(&writer->room);
+        pthread_cond_destroy(&writer->wake);
+        pthread_mutex_destroy(&writer->lock);
+        free(writer->buf);
+        writer->buf = NULL;
+        return -1;
+    }
+
+    return 0;
+}
+
+int ge_writer_deinit(struct ge_writer *writer)
+{
+    int error;
+
+    if (writer->buf == NULL)
+        return 0;
+
+    pthread_mutex_lock(&writer->lock);
+    writer->stop = 1;
+    pthread_cond_signal(&writer->wake);
+    pthread_mutex_unlock(&writer->lock);
+
+    pthread_join(writer->thread, NULL);
+    error = writer->error;
+
+    pthread_cond_destroy(&writer->room);
+    pthread_cond_destroy(&writer->wake);
+    pthread_mutex_destroy(&writer->lock);
+    free(writer->buf);
+    writer->buf = NULL;
+
+    return error;
+}
+
+int ge_writer_put(struct ge_writer *writer, const void *data, size_t size)
+{
+    const uint8_t *p = data;
+    uint64_t head = atomic_load_explicit(&writer->head, memory_order_relaxed);
+    uint64_t tail;
+    uint32_t start, count;
+    int error;
+
+    while (size > 0) {
+        tail = atomic_load_explicit(&writer->tail, memory_order_acquire);
+
+        /* full, wait for the thread to make room */
+        if (head - tail == writer->size) {
+            pthread_mutex_lock(&writer->lock);
+            pthread_cond_signal(&writer->wake);
+            while (atomic_load_explicit(&writer->tail, memory_order_acquire) == tail &&
+                   !writer->error)
+                pthread_cond_wait(&writer->room, &writer->lock);
+            error = writer->error;
+            pthread_mutex_unlock(&writer->lock);
+
+            if (error)
+                return -1;
+            continue;
+        }
+
+        start = head & (writer->size - 1);
+        count = writer->size - start;
+        if (count > writer->size - (head - tail))
+            count = writer->size - (head - tail);
+        if (count > size)
+            count = size;
+
+        memcpy(writer->buf + start, p, count);
+        head += count;
+        p += count;
+        size -= count;
+        atomic_store_explicit(&writer->head, head, memory_order_release);
+    }
+
+    pthread_mutex_lock(&writer->lock);
+    error = writer->error;
+    pthread_cond_signal(&writer->wake);
+    pthread_mutex_unlock(&writer->lock);
+
+    return error ? -1 : 0;
+}
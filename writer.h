@@ -0,0 +1,70 @@
+/**
+ * @file  writer.h
+ * @brief Buffered writer thread
+ *
+ * Writes to a file from a thread of its own, so the emulator never waits
+ * for the disk: the data is copied in a ring buffer and written out by
+ * the thread, which sleeps while there is nothing to write.
+ *
+ * Single producer: only one thread may call ge_writer_put(). When the
+ * ring buffer is full the producer waits for the writer to make room,
+ * the data is never dropped.
+ */
+
+#ifndef WRITER_H
+#define WRITER_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/// Default size of the ring buffer
+#define GE_WRITER_SIZE (1 << 20)
+
+struct ge_writer {
+    uint8_t *buf;
+    uint32_t size; ///< Size of the ring buffer, a power of two
+
+    _Atomic uint64_t head; ///< Next byte to put, owned by the producer
+    _Atomic uint64_t tail; ///< Next byte to write, owned by the thread
+
+    FILE *file;
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;  ///< Data to write, or stop
+    pthread_cond_t room;  ///< Data written
+
+    uint8_t stop;  ///< Write what is left and exit, under `lock`
+    int error;     ///< Set by the thread on write errors, under `lock`
+};
+
+/**
+ * Start a writer
+ *
+ * @param writer the writer to start
+ * @param file   where to write, not closed by the writer
+ * @param size   size of the ring buffer, rounded up to a power of two
+ * @return 0 on success, -1 if the buffer or the thread cannot be created
+ */
+int ge_writer_init(struct ge_writer *writer, FILE *file, uint32_t size);
+
+/**
+ * Stop a writer
+ *
+ * Waits for the data to be written, stops the thread and frees the
+ * buffer.
+ *
+ * @return 0 on success, -1 if some data could not be written
+ */
+int ge_writer_deinit(struct ge_writer *writer);
+
+/**
+ * Queue data to be written
+ *
+ * @return 0 on success, -1 if the writer has failed
+ */
+int ge_writer_put(struct ge_writer *writer, const void *data, size_t size);
+
+#endif /* WRITER_H */